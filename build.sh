@@ -12,6 +12,8 @@ NC='\033[0m' # No Color
 
 # Compiler settings
 CC=gcc
+CXX=g++
+CXXSTD="-std=c++20"
 COMMON_FLAGS="-Wall -Wextra -pedantic"
 DEBUG_FLAGS="-g -O0 -DDEBUG"
 RELEASE_FLAGS="-O3 -DNDEBUG"
@@ -19,13 +21,16 @@ RELEASE_FLAGS="-O3 -DNDEBUG"
 # Library and test targets
 LIB_NAME="memory_arena"
 TEST_NAME="memory_arena_test"
+COROUTINE_TEST_NAME="memory_arena_coroutine_test"
 
 # Default build mode
 BUILD_TYPE="release"
 
 # Source files (space-separated lists instead of arrays)
-LIB_SOURCES="memory_arena.c"
-TEST_SOURCES="game_test.c memory_arena.c"
+LIB_SOURCES="memory_arena.c memory_arena_soa.c memory_arena_intern.c memory_arena_snapshot.c memory_arena_queue.c memory_arena_shared.c memory_arena_file.c"
+TEST_SOURCES="game_test.c memory_arena.c memory_arena_soa.c memory_arena_intern.c memory_arena_snapshot.c memory_arena_queue.c memory_arena_shared.c memory_arena_file.c"
+
+COROUTINE_TEST_SOURCES="memory_arena_coroutine_test.cpp"
 
 # Directory structure
 SRC_DIR="src"
@@ -66,6 +71,7 @@ show_help() {
     echo "  all            Build library and tests (default)"
     echo "  lib            Build only the library"
     echo "  test           Build the memory arena test"
+    echo "  coroutine      Build the C++20 coroutine test"
     echo "  clean          Remove build artifacts"
     echo ""
     echo "Examples:"
@@ -159,6 +165,18 @@ build_test() {
     echo_success "Built ${TEST_NAME}.exe"
 }
 
+# Build the C++20 coroutine test against the library
+build_coroutine_test() {
+    echo_info "Building $COROUTINE_TEST_NAME..."
+    check_sources "$COROUTINE_TEST_SOURCES"
+
+    $CXX $CXXSTD $CFLAGS -I"$SRC_DIR" "$SRC_DIR/$COROUTINE_TEST_SOURCES" "$BIN_DIR/lib${LIB_NAME}.a" -o "$BIN_DIR/${COROUTINE_TEST_NAME}.exe" 2>&1 || {
+        echo_error "Failed to build $COROUTINE_TEST_NAME"
+    }
+
+    echo_success "Built ${COROUTINE_TEST_NAME}.exe"
+}
+
 # Parse command line arguments
 TARGET="all"
 
@@ -176,7 +194,7 @@ while [ "$#" -gt 0 ]; do
             BUILD_TYPE="release"
             shift
             ;;
-        all|lib|test|clean)
+        all|lib|test|coroutine|clean)
             TARGET="$1"
             shift
             ;;
@@ -206,6 +224,11 @@ case "$TARGET" in
         create_directories
         build_test
         ;;
+    coroutine)
+        create_directories
+        build_lib
+        build_coroutine_test
+        ;;
     clean)
         clean
         ;;
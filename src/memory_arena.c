@@ -4,13 +4,6 @@
 #include <assert.h>
 #include <stdio.h>
 
-static inline
-uintptr_t
-__align_forward(uintptr_t addr, uintptr_t align)
-{
-	return (addr + (align - 1)) & ~(align - 1);
-}
-
 void
 memory_arena_init(MemoryArena* arena, uintptr_t minimum_block_capacity)
 {
@@ -80,6 +73,7 @@ memory_arena_scope_end(MemoryArenaScope scope)
 	}
 
 	arena->scope_count--;
+	arena->rewind_count++;
 }
 
 void
@@ -94,6 +88,7 @@ memory_arena_clear(MemoryArena* arena)
 	if (arena->head_block)
 		arena->head_block->top = 0;
 
+	arena->rewind_count++;
 }
 
 static inline
@@ -112,6 +107,7 @@ __memory_arena_new_block(MemoryArena* arena, MemoryArenaBlockFooter* current_blo
 	*new_block = (MemoryArenaBlockFooter){0};
 	new_block->next = current_block;
 	new_block->capacity = memory_block_size - sizeof(MemoryArenaBlockFooter);
+	new_block->serial = ++arena->block_serial;
 
 	//TODO(Alan): Clear to zero the memory in debug (or flag controled ?)
 
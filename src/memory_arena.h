@@ -31,14 +31,26 @@
 |
 */
 
+# ifdef __cplusplus
+extern "C" {
+# endif
+
 #define MAX(X, Y) (((X) > (Y)) ? (X) : (Y))
 #define MIN(X, Y) (((X) > (Y)) ? (Y) : (X))
 
+static inline
+uintptr_t
+__align_forward(uintptr_t addr, uintptr_t align)
+{
+	return (addr + (align - 1)) & ~(align - 1);
+}
+
 typedef struct MemoryArenaBlockFooter
 {
 	struct MemoryArenaBlockFooter* next;
 	uintptr_t capacity;
 	uintptr_t top;
+	uintptr_t serial;
 	//NOTE(Alan): The raw data is right behind this struct in one allocated space
 	//	[[FOOTER]-PADDING-[RAW_DATA]]
 }
@@ -49,6 +61,10 @@ typedef struct
 	MemoryArenaBlockFooter* head_block;
 	uintptr_t minimum_block_capacity;
 	uintptr_t scope_count;
+	//NOTE: Never reused, tells a block apart from a new one malloc'd at the same address
+	uintptr_t block_serial;
+	//NOTE: Bumped whenever a top moves back (clear, scope end), memory handed out before may be reused
+	uintptr_t rewind_count;
 }
 MemoryArena;
 
@@ -83,4 +99,8 @@ memory_arena_push(MemoryArena* arena, uintptr_t size, uintptr_t alignment);
 # define memory_arena_alloc(ARENA, TYPE) (TYPE*)memory_arena_push(ARENA, sizeof(TYPE), _Alignof(TYPE))
 # define memory_arena_alloc_array(ARENA, TYPE, COUNT) (TYPE*)memory_arena_push(ARENA, sizeof(TYPE) * COUNT, _Alignof(TYPE))
 
+# ifdef __cplusplus
+}
+# endif
+
 #endif
@@ -0,0 +1,241 @@
+
+#ifndef MEMORY_ARENA_COROUTINE_HPP
+# define MEMORY_ARENA_COROUTINE_HPP
+
+# include "memory_arena.h"
+# include <coroutine>
+# include <cstddef>
+# include <exception>
+# include <new>
+# include <optional>
+# include <type_traits>
+# include <utility>
+
+/*
+| #MEMORY_ARENA_COROUTINE :C++20
+|
+|| #FRAME :ARENA_PUSH
+|| [[HEADER]-[COROUTINE_FRAME]]
+|| >arena (NULL when the frame came from the heap)
+|
+| >MemoryArena& as first coroutine parameter, second after the object of a member coroutine (per task)
+| >thread_arena (per thread, see ArenaScope)
+| >global operator new (fallback)
+|
+*/
+
+namespace memory_arena
+{
+	inline thread_local MemoryArena* thread_arena = nullptr;
+
+	//NOTE: Frames of coroutines started inside the scope come from the arena
+	class ArenaScope
+	{
+	public:
+		explicit ArenaScope(MemoryArena* arena) : previous(thread_arena) { thread_arena = arena; }
+		~ArenaScope() { thread_arena = previous; }
+
+		ArenaScope(const ArenaScope&) = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+	private:
+		MemoryArena* previous;
+	};
+
+	struct FrameHeader
+	{
+		MemoryArena* arena;
+	};
+
+	inline constexpr std::size_t frame_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+	inline constexpr std::size_t frame_header_size = (sizeof(FrameHeader) + frame_alignment - 1) & ~(frame_alignment - 1);
+
+	inline
+	void*
+	allocate_frame(MemoryArena* arena, std::size_t size)
+	{
+		void* raw = arena
+			? memory_arena_push(arena, frame_header_size + size, frame_alignment)
+			: ::operator new(frame_header_size + size, std::nothrow);
+
+		if (raw == nullptr)
+			throw std::bad_alloc();
+
+		static_cast<FrameHeader*>(raw)->arena = arena;
+
+		return static_cast<char*>(raw) + frame_header_size;
+	}
+
+	inline
+	void
+	deallocate_frame(void* frame, std::size_t size) noexcept
+	{
+		char* raw = static_cast<char*>(frame) - frame_header_size;
+		MemoryArena* arena = reinterpret_cast<FrameHeader*>(raw)->arena;
+
+		if (arena == nullptr)
+		{
+			::operator delete(raw);
+			return;
+		}
+
+		//NOTE: LIFO rewind, only the most recent push of the head block can be given back
+		MemoryArenaBlockFooter* block = arena->head_block;
+
+		if (block == nullptr)
+			return;
+
+		uintptr_t data = reinterpret_cast<uintptr_t>(block + 1);
+
+		if (reinterpret_cast<uintptr_t>(frame) + size == data + block->top)
+		{
+			block->top = reinterpret_cast<uintptr_t>(raw) - data;
+			arena->rewind_count++;
+		}
+	}
+
+	//NOTE: Derive a promise_type from this to get arena-backed frames, Params are the coroutine parameter
+	//	types as given to std::coroutine_traits. ArenaPromise<> only knows about thread_arena.
+	template <typename... Params>
+	struct ArenaPromise
+	{
+		static void* operator new(std::size_t size) { return allocate_frame(thread_arena, size); }
+		static void operator delete(void* frame, std::size_t size) noexcept { deallocate_frame(frame, size); }
+	};
+
+	//NOTE: Neither is a function template on purpose, GCC flags a templated placement new
+	//	or one from another class paired with the usual delete
+	template <typename... Params>
+	struct ArenaPromise<MemoryArena&, Params...>
+	{
+		static void* operator new(std::size_t size, MemoryArena& arena, Params&...) { return allocate_frame(&arena, size); }
+		static void operator delete(void* frame, std::size_t size) noexcept { deallocate_frame(frame, size); }
+	};
+
+	//NOTE: Member coroutines, std::coroutine_traits puts the object before the parameters
+	template <typename Object, typename... Params>
+		requires (!std::is_same_v<Object, MemoryArena&>)
+	struct ArenaPromise<Object, MemoryArena&, Params...>
+	{
+		static void* operator new(std::size_t size, Object&, MemoryArena& arena, Params&...) { return allocate_frame(&arena, size); }
+		static void operator delete(void* frame, std::size_t size) noexcept { deallocate_frame(frame, size); }
+	};
+
+	template <typename T>
+	class Task;
+
+	namespace detail
+	{
+		template <typename T>
+		struct TaskResult
+		{
+			std::optional<T> value;
+
+			void return_value(T result) { value.emplace(std::move(result)); }
+			T take() { return std::move(*value); }
+		};
+
+		template <>
+		struct TaskResult<void>
+		{
+			void return_void() noexcept {}
+			void take() noexcept {}
+		};
+
+		template <typename T>
+		struct TaskPromiseBase : TaskResult<T>
+		{
+			std::coroutine_handle<> continuation;
+			std::exception_ptr exception;
+
+			struct FinalAwaiter
+			{
+				bool await_ready() noexcept { return false; }
+
+				template <typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+				{
+					std::coroutine_handle<> continuation = handle.promise().continuation;
+
+					return continuation ? continuation : std::noop_coroutine();
+				}
+
+				void await_resume() noexcept {}
+			};
+
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			FinalAwaiter final_suspend() noexcept { return {}; }
+			void unhandled_exception() noexcept { exception = std::current_exception(); }
+		};
+
+		template <typename T, typename... Params>
+		struct TaskPromise : ArenaPromise<Params...>, TaskPromiseBase<T>
+		{
+			Task<T> get_return_object() noexcept;
+		};
+	}
+
+	//NOTE: Lazy task, starts on co_await or resume() and resumes its awaiter when done
+	template <typename T = void>
+	class Task
+	{
+	public:
+		Task(std::coroutine_handle<> handle, detail::TaskPromiseBase<T>* promise) noexcept : handle(handle), promise(promise) {}
+		Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)), promise(std::exchange(other.promise, nullptr)) {}
+		~Task() { if (handle) handle.destroy(); }
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (handle)
+					handle.destroy();
+				handle = std::exchange(other.handle, nullptr);
+				promise = std::exchange(other.promise, nullptr);
+			}
+			return *this;
+		}
+
+		bool done() const noexcept { return !handle || handle.done(); }
+		void resume() { if (!done()) handle.resume(); }
+
+		T result()
+		{
+			if (promise->exception)
+				std::rethrow_exception(promise->exception);
+			return promise->take();
+		}
+
+		bool await_ready() const noexcept { return done(); }
+
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept
+		{
+			promise->continuation = awaiter;
+			return handle;
+		}
+
+		T await_resume() { return result(); }
+
+	private:
+		//NOTE: The promise type depends on the coroutine parameters, only its base is kept
+		std::coroutine_handle<> handle;
+		detail::TaskPromiseBase<T>* promise;
+	};
+
+	template <typename T, typename... Params>
+	Task<T>
+	detail::TaskPromise<T, Params...>::get_return_object() noexcept
+	{
+		return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this), this);
+	}
+}
+
+template <typename T, typename... Params>
+struct std::coroutine_traits<memory_arena::Task<T>, Params...>
+{
+	using promise_type = memory_arena::detail::TaskPromise<T, Params...>;
+};
+
+#endif
@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdexcept>
+#include "memory_arena_coroutine.hpp"
+
+// Unlike assert, stays in release builds
+#define CHECK(EXPR) do { \
+	if (!(EXPR)) { \
+		fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #EXPR); \
+		abort(); \
+	} \
+} while (0)
+
+using memory_arena::ArenaScope;
+using memory_arena::Task;
+
+// Helper to check whether a pointer lives inside the arena's head block
+static bool in_head_block(MemoryArena* arena, void* ptr)
+{
+	uintptr_t data = (uintptr_t)(arena->head_block + 1);
+	return (uintptr_t)ptr >= data && (uintptr_t)ptr < data + arena->head_block->capacity;
+}
+
+static void* last_frame = nullptr;
+
+struct FrameProbe
+{
+	bool await_ready() noexcept { return false; }
+	bool await_suspend(std::coroutine_handle<> handle) noexcept { last_frame = handle.address(); return false; }
+	void await_resume() noexcept {}
+};
+
+Task<int> add(int a, int b)
+{
+	co_await FrameProbe{};
+	co_return a + b;
+}
+
+Task<int> sum_to(int n)
+{
+	int total = 0;
+	for (int i = 1; i <= n; i++)
+		total = co_await add(total, i);
+	co_return total;
+}
+
+Task<int> per_task(MemoryArena& arena, int value)
+{
+	(void)arena;
+	co_await FrameProbe{};
+	co_return value * 2;
+}
+
+struct Scaler
+{
+	int factor;
+
+	Task<int> scale(MemoryArena& arena, int value)
+	{
+		(void)arena;
+		co_await FrameProbe{};
+		co_return value * factor;
+	}
+};
+
+Task<> fail()
+{
+	throw std::runtime_error("fail");
+	co_return;
+}
+
+void test_thread_arena_frames()
+{
+	printf("Testing coroutine frames from the thread arena...\n");
+
+	MemoryArena arena;
+	memory_arena_init(&arena, 4096);
+	// Keep the top on a frame boundary so a rewind lands exactly on it
+	memory_arena_push(&arena, memory_arena::frame_alignment, memory_arena::frame_alignment);
+
+	{
+		ArenaScope scope(&arena);
+		uintptr_t top_before = arena.head_block->top;
+
+		Task<int> task = sum_to(10);
+		uintptr_t top_with_task = arena.head_block->top;
+		CHECK(top_with_task > top_before);
+		task.resume();
+		CHECK(task.done());
+		CHECK(task.result() == 55);
+		CHECK(in_head_block(&arena, last_frame));
+
+		// Awaited frames were destroyed in LIFO order and rewound, only the outer one is left
+		CHECK(arena.head_block->top == top_with_task);
+
+		Task<int> other = add(1, 2);
+		uintptr_t add_frame_size = arena.head_block->top - top_with_task;
+		CHECK(add_frame_size > 0);
+		other.resume();
+		CHECK(other.result() == 3);
+		CHECK(arena.head_block->top == top_with_task + add_frame_size);
+
+		// The new frame is pushed before the old one is destroyed, neither reassignment can rewind
+		other = add(3, 4);
+		CHECK(arena.head_block->top == top_with_task + add_frame_size * 2);
+		task = add(5, 6);
+		CHECK(arena.head_block->top == top_with_task + add_frame_size * 3);
+	}
+
+	// Outside the scope frames come from the heap again
+	Task<int> heap_task = add(2, 2);
+	heap_task.resume();
+	CHECK(heap_task.result() == 4);
+	CHECK(arena.head_block == nullptr || !in_head_block(&arena, last_frame));
+
+	memory_arena_destroy(&arena);
+	printf("✓ Thread arena frames test passed\n");
+}
+
+void test_per_task_arena_frames()
+{
+	printf("Testing coroutine frames from a per-task arena...\n");
+
+	MemoryArena arena;
+	memory_arena_init(&arena, 4096);
+	// Keep the top on a frame boundary so a rewind lands exactly on it
+	memory_arena_push(&arena, memory_arena::frame_alignment, memory_arena::frame_alignment);
+	uintptr_t top_before = arena.head_block->top;
+
+	{
+		Task<int> task = per_task(arena, 21);
+		CHECK(arena.head_block->top > top_before);
+		task.resume();
+		CHECK(task.result() == 42);
+		CHECK(in_head_block(&arena, last_frame));
+	}
+
+	// Last frame in the arena was handed back on destruction
+	CHECK(arena.head_block->top == top_before);
+
+	// Non-LIFO destruction leaves the memory to the arena
+	Task<int>* first = new Task<int>(per_task(arena, 1));
+	Task<int>* second = new Task<int>(per_task(arena, 2));
+	uintptr_t top_after_two = arena.head_block->top;
+	delete first;
+	CHECK(arena.head_block->top == top_after_two);
+	delete second;
+	CHECK(arena.head_block->top < top_after_two);
+
+	// Member coroutines take the arena right after the object
+	MemoryArena member_arena;
+	memory_arena_init(&member_arena, 4096);
+	{
+		Scaler scaler = {3};
+		Task<int> task = scaler.scale(member_arena, 5);
+		CHECK(member_arena.head_block != nullptr);
+		task.resume();
+		CHECK(task.result() == 15);
+		CHECK(in_head_block(&member_arena, last_frame));
+	}
+	CHECK(member_arena.head_block->top == 0);
+	memory_arena_destroy(&member_arena);
+
+	memory_arena_destroy(&arena);
+	printf("✓ Per-task arena frames test passed\n");
+}
+
+void test_task_exceptions()
+{
+	printf("Testing task exceptions...\n");
+
+	MemoryArena arena;
+	memory_arena_init(&arena, 1024);
+	bool caught = false;
+	{
+		ArenaScope scope(&arena);
+
+		Task<> task = fail();
+		task.resume();
+		CHECK(task.done());
+
+		try {
+			task.result();
+		} catch (const std::runtime_error&) {
+			caught = true;
+		}
+	}
+	CHECK(caught);
+
+	memory_arena_destroy(&arena);
+	printf("✓ Task exceptions test passed\n");
+}
+
+int main()
+{
+	printf("=== Memory Arena Coroutine Test Suite ===\n");
+
+	test_thread_arena_frames();
+	test_per_task_arena_frames();
+	test_task_exceptions();
+
+	printf("All tests passed successfully!\n");
+	return 0;
+}
@@ -0,0 +1,675 @@
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+# define _GNU_SOURCE
+#endif
+
+#include "memory_arena_file.h"
+#include <stdlib.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#if defined(__linux__) && defined(__has_include)
+# if __has_include(<linux/io_uring.h>)
+#  define MEMORY_ARENA_FILE_URING
+# endif
+#endif
+
+#ifdef MEMORY_ARENA_FILE_URING
+# include <linux/io_uring.h>
+# include <sched.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+#endif
+
+#ifndef O_DIRECT
+# define O_DIRECT 0
+#endif
+
+typedef struct
+{
+	int fd;
+	uintptr_t length;
+	uintptr_t done;
+}
+MemoryArenaFileJob;
+
+static inline
+int
+__memory_arena_file_open(const char* path, uint32_t flags, bool* direct)
+{
+	int fd = -1;
+
+	*direct = false;
+
+	if ((flags & MEMORY_ARENA_FILE_DIRECT) && O_DIRECT != 0)
+	{
+		fd = open(path, O_RDONLY | O_CLOEXEC | O_DIRECT);
+		*direct = fd >= 0;
+		//NOTE: tmpfs and friends refuse O_DIRECT, read them through the page cache
+		if (fd >= 0 || errno != EINVAL)
+			return fd;
+	}
+
+	return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+//NOTE: Reads [offset + done, offset + length) into data + done, stops once want bytes are in or at EOF
+static inline
+int
+__memory_arena_file_pread(int fd, uint8_t* data, uintptr_t length, uintptr_t want, uintptr_t offset, uintptr_t* done)
+{
+	while (*done < want)
+	{
+		ssize_t result = pread(fd, data + *done, length - *done, (off_t)(offset + *done));
+
+		if (result < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return errno;
+		}
+		if (result == 0)
+			break;
+
+		*done += (uintptr_t)result;
+	}
+
+	return 0;
+}
+
+#ifdef MEMORY_ARENA_FILE_URING
+
+//NOTE: Bare io_uring over the raw syscalls, liburing is not a dependency
+typedef struct
+{
+	int fd;
+	unsigned* sq_head;
+	unsigned* sq_tail;
+	unsigned* sq_mask;
+	unsigned* sq_array;
+	unsigned* cq_head;
+	unsigned* cq_tail;
+	unsigned* cq_mask;
+	struct io_uring_sqe* sqes;
+	struct io_uring_cqe* cqes;
+	void* sq_ring;
+	uintptr_t sq_ring_size;
+	void* cq_ring;
+	uintptr_t cq_ring_size;
+	uintptr_t sqes_size;
+	unsigned entries;
+	unsigned to_submit;
+}
+MemoryArenaFileUring;
+
+static
+void
+__memory_arena_file_uring_destroy(MemoryArenaFileUring* ring)
+{
+	if (ring->sqes)
+		munmap(ring->sqes, ring->sqes_size);
+	if (ring->cq_ring && ring->cq_ring != ring->sq_ring)
+		munmap(ring->cq_ring, ring->cq_ring_size);
+	if (ring->sq_ring)
+		munmap(ring->sq_ring, ring->sq_ring_size);
+	if (ring->fd >= 0)
+		close(ring->fd);
+
+	*ring = (MemoryArenaFileUring){0};
+	ring->fd = -1;
+}
+
+static
+bool
+__memory_arena_file_uring_init(MemoryArenaFileUring* ring, unsigned entries)
+{
+	struct io_uring_params params;
+
+	memset(&params, 0, sizeof(params));
+	*ring = (MemoryArenaFileUring){0};
+	ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+
+	if (ring->fd < 0)
+		return false;
+
+	ring->entries = params.sq_entries;
+	ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+		ring->sq_ring_size = ring->cq_ring_size = MAX(ring->sq_ring_size, ring->cq_ring_size);
+
+	ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	if (ring->sq_ring == MAP_FAILED)
+	{
+		ring->sq_ring = NULL;
+		__memory_arena_file_uring_destroy(ring);
+		return false;
+	}
+
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+		ring->cq_ring = ring->sq_ring;
+	else
+	{
+		ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+		if (ring->cq_ring == MAP_FAILED)
+		{
+			ring->cq_ring = NULL;
+			__memory_arena_file_uring_destroy(ring);
+			return false;
+		}
+	}
+
+	ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+	if (ring->sqes == MAP_FAILED)
+	{
+		ring->sqes = NULL;
+		__memory_arena_file_uring_destroy(ring);
+		return false;
+	}
+
+	uint8_t* sq = ring->sq_ring;
+	uint8_t* cq = ring->cq_ring;
+
+	ring->sq_head = (unsigned*)(sq + params.sq_off.head);
+	ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+	ring->sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+	ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+	ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+	ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+	ring->cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+
+	return true;
+}
+
+//NOTE: Callers never keep more than ring->entries reads in flight, so there is always room
+static
+void
+__memory_arena_file_uring_read(MemoryArenaFileUring* ring, int fd, void* buffer, uintptr_t length, uintptr_t offset, uint64_t user_data)
+{
+	unsigned tail = *ring->sq_tail;
+	unsigned index = tail & *ring->sq_mask;
+	struct io_uring_sqe* sqe = &ring->sqes[index];
+
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = IORING_OP_READ;
+	sqe->fd = fd;
+	sqe->addr = (uint64_t)(uintptr_t)buffer;
+	sqe->len = (uint32_t)MIN(length, 1u << 30);
+	sqe->off = offset;
+	sqe->user_data = user_data;
+
+	ring->sq_array[index] = index;
+	__atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	ring->to_submit++;
+}
+
+static
+int
+__memory_arena_file_uring_submit(MemoryArenaFileUring* ring, unsigned wait_count)
+{
+	for (;;)
+	{
+		long result = syscall(__NR_io_uring_enter, ring->fd, ring->to_submit, wait_count,
+			wait_count ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+
+		if (result >= 0)
+		{
+			ring->to_submit -= (unsigned)result;
+			return 0;
+		}
+		if (errno != EINTR)
+			return errno;
+	}
+}
+
+//NOTE: Takes back the entries the kernel never saw after a failed submit, fine without SQPOLL
+static
+void
+__memory_arena_file_uring_unqueue(MemoryArenaFileUring* ring)
+{
+	__atomic_store_n(ring->sq_tail, *ring->sq_tail - ring->to_submit, __ATOMIC_RELEASE);
+	ring->to_submit = 0;
+}
+
+//NOTE: Blocks until a completion is there to peek. A read the kernel took owns its buffer until
+//	then, so there is no giving up: when entering the ring fails the completion is polled for.
+//	Returns the last error other than EAGAIN/EBUSY, the ring should not be trusted after one.
+static
+int
+__memory_arena_file_uring_wait(MemoryArenaFileUring* ring)
+{
+	int failure = 0;
+
+	while (*ring->cq_head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE))
+	{
+		int error = __memory_arena_file_uring_submit(ring, 1);
+
+		if (error == 0)
+			continue;
+		if (error != EAGAIN && error != EBUSY)
+			failure = error;
+		sched_yield();
+	}
+
+	return failure;
+}
+
+static
+bool
+__memory_arena_file_uring_peek(MemoryArenaFileUring* ring, uint64_t* user_data, int32_t* result)
+{
+	unsigned head = *ring->cq_head;
+
+	if (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE))
+		return false;
+
+	struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+
+	*user_data = cqe->user_data;
+	*result = cqe->res;
+	__atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+
+	return true;
+}
+
+//NOTE: Returns how many reads left the ring for good, short reads are queued again when resubmit is set
+static
+unsigned
+__memory_arena_file_uring_reap(MemoryArenaFileUring* ring, MemoryArenaFile* files, MemoryArenaFileJob* jobs, bool resubmit)
+{
+	unsigned finished = 0;
+	uint64_t index;
+	int32_t result;
+
+	while (__memory_arena_file_uring_peek(ring, &index, &result))
+	{
+		MemoryArenaFileJob* job = &jobs[index];
+
+		finished++;
+
+		if (result == -EINTR || result == -EAGAIN)
+			result = 0;
+		else if (result < 0)
+		{
+			//NOTE: Kernels without IORING_OP_READ answer EINVAL, pread takes over below
+			if (result != -EINVAL)
+				files[index].error = -result;
+			continue;
+		}
+		else if (result == 0)
+		{
+			job->length = job->done;
+			continue;
+		}
+
+		job->done += (uintptr_t)result;
+		if (resubmit && job->done < MIN(job->length, files[index].size))
+		{
+			__memory_arena_file_uring_read(ring, job->fd, (uint8_t*)files[index].data + job->done,
+				job->length - job->done, job->done, index);
+			finished--;
+		}
+	}
+
+	return finished;
+}
+
+static
+void
+__memory_arena_file_read_uring(MemoryArenaFileUring* ring, MemoryArenaFile* files, MemoryArenaFileJob* jobs, uintptr_t count)
+{
+	uintptr_t next = 0;
+	unsigned in_flight = 0;
+
+	while (next < count || in_flight > 0)
+	{
+		for (; next < count && in_flight < ring->entries; next++)
+		{
+			if (jobs[next].fd < 0 || jobs[next].length == 0)
+				continue;
+
+			__memory_arena_file_uring_read(ring, jobs[next].fd, files[next].data, jobs[next].length, 0, next);
+			in_flight++;
+		}
+
+		if (in_flight == 0)
+			break;
+
+		if (__memory_arena_file_uring_submit(ring, 1) != 0)
+		{
+			//NOTE: Reads the kernel already took still land in the arena, they have to be reaped
+			//	before the ring goes away. Whatever did not complete goes through pread afterwards.
+			in_flight -= ring->to_submit;
+			__memory_arena_file_uring_unqueue(ring);
+
+			while ((in_flight -= __memory_arena_file_uring_reap(ring, files, jobs, false)) > 0)
+				__memory_arena_file_uring_wait(ring);
+
+			return;
+		}
+
+		in_flight -= __memory_arena_file_uring_reap(ring, files, jobs, true);
+	}
+}
+
+#endif
+
+bool
+memory_arena_read_files(MemoryArena* arena, MemoryArenaFile* files, uintptr_t count, uint32_t flags)
+{
+	assert(arena != NULL);
+	assert(files != NULL || count == 0);
+
+	MemoryArenaFileJob* jobs = malloc(sizeof(MemoryArenaFileJob) * MAX(count, 1));
+	bool ok = true;
+
+	if (jobs == NULL)
+		return false;
+
+	//NOTE: Every buffer is reserved up front, the reads then land in the arena directly
+	for (uintptr_t i = 0; i < count; i++)
+	{
+		MemoryArenaFile* file = &files[i];
+		MemoryArenaFileJob* job = &jobs[i];
+		struct stat info;
+		bool direct;
+
+		*job = (MemoryArenaFileJob){0};
+		job->fd = __memory_arena_file_open(file->path, flags, &direct);
+		file->data = NULL;
+		file->size = 0;
+		file->error = 0;
+		file->direct = direct;
+
+		if (job->fd < 0)
+		{
+			file->error = errno;
+			continue;
+		}
+
+		if (fstat(job->fd, &info) != 0)
+		{
+			file->error = errno;
+			close(job->fd);
+			job->fd = -1;
+			continue;
+		}
+
+		uintptr_t size = (uintptr_t)info.st_size;
+		uintptr_t alignment = direct ? MEMORY_ARENA_FILE_DIRECT_ALIGNMENT : 16;
+		uintptr_t capacity = direct ? __align_forward(size + 1, alignment) : size + 1;
+
+		file->data = memory_arena_push(arena, capacity, alignment);
+		file->size = size;
+		job->length = direct ? __align_forward(size, alignment) : size;
+
+		if (file->data == NULL)
+		{
+			file->error = ENOMEM;
+			close(job->fd);
+			job->fd = -1;
+		}
+	}
+
+#ifdef MEMORY_ARENA_FILE_URING
+	if (count > 1 && !(flags & MEMORY_ARENA_FILE_NO_URING))
+	{
+		MemoryArenaFileUring ring;
+
+		if (__memory_arena_file_uring_init(&ring, (unsigned)MIN(count, MEMORY_ARENA_FILE_QUEUE_DEPTH)))
+		{
+			__memory_arena_file_read_uring(&ring, files, jobs, count);
+			__memory_arena_file_uring_destroy(&ring);
+		}
+	}
+#endif
+
+	for (uintptr_t i = 0; i < count; i++)
+	{
+		MemoryArenaFile* file = &files[i];
+		MemoryArenaFileJob* job = &jobs[i];
+
+		if (job->fd < 0)
+		{
+			ok = false;
+			continue;
+		}
+
+		//NOTE: pread fallback, also finishes anything the ring left behind
+		if (file->error == 0 && job->done < MIN(job->length, file->size))
+			file->error = __memory_arena_file_pread(job->fd, file->data, job->length, file->size, 0, &job->done);
+
+		close(job->fd);
+
+		if (file->error != 0)
+		{
+			file->data = NULL;
+			file->size = 0;
+			ok = false;
+			continue;
+		}
+
+		//NOTE: The file may have shrunk since fstat
+		file->size = MIN(file->size, job->done);
+		((uint8_t*)file->data)[file->size] = '\0';
+	}
+
+	free(jobs);
+
+	return ok;
+}
+
+void*
+memory_arena_read_file(MemoryArena* arena, const char* path, uintptr_t* size, uint32_t flags)
+{
+	assert(arena != NULL);
+	assert(path != NULL);
+
+	MemoryArenaFile file = {0};
+
+	file.path = path;
+	memory_arena_read_files(arena, &file, 1, flags | MEMORY_ARENA_FILE_NO_URING);
+
+	if (size)
+		*size = file.size;
+
+	return file.data;
+}
+
+static inline
+uintptr_t
+__memory_arena_file_stream_chunk(MemoryArenaFileStream* stream)
+{
+	return MIN(stream->chunk_size, stream->file_size - stream->offset);
+}
+
+#ifdef MEMORY_ARENA_FILE_URING
+//NOTE: Only with nothing in flight, the stream goes on with pread for good
+static inline
+void
+__memory_arena_file_stream_drop_uring(MemoryArenaFileStream* stream)
+{
+	assert(!stream->in_flight);
+
+	__memory_arena_file_uring_destroy(stream->uring);
+	free(stream->uring);
+	stream->uring = NULL;
+}
+
+static inline
+void
+__memory_arena_file_stream_submit(MemoryArenaFileStream* stream)
+{
+	MemoryArenaFileUring* ring = stream->uring;
+	uintptr_t length = stream->direct ? stream->chunk_size : __memory_arena_file_stream_chunk(stream);
+
+	//NOTE: Tagged with its buffer, a completion can never be taken for the other one
+	__memory_arena_file_uring_read(ring, stream->fd, stream->buffers[stream->next_buffer], length, stream->offset,
+		stream->next_buffer + 1);
+	stream->in_flight = __memory_arena_file_uring_submit(ring, 0) == 0;
+
+	if (!stream->in_flight)
+	{
+		__memory_arena_file_uring_unqueue(ring);
+		__memory_arena_file_stream_drop_uring(stream);
+	}
+}
+
+//NOTE: Returns the result of the read, the buffer belongs to the stream again afterwards
+static inline
+int32_t
+__memory_arena_file_stream_wait(MemoryArenaFileStream* stream)
+{
+	MemoryArenaFileUring* ring = stream->uring;
+	int error = __memory_arena_file_uring_wait(ring);
+	uint64_t user_data = 0;
+	int32_t result = 0;
+
+	__memory_arena_file_uring_peek(ring, &user_data, &result);
+	assert(user_data == stream->next_buffer + 1);
+	stream->in_flight = false;
+
+	if (error != 0)
+		__memory_arena_file_stream_drop_uring(stream);
+
+	return result;
+}
+#endif
+
+bool
+memory_arena_file_stream_open(MemoryArenaFileStream* stream, MemoryArena* arena, const char* path, uintptr_t chunk_size, uint32_t flags)
+{
+	assert(stream != NULL);
+	assert(arena != NULL);
+	assert(path != NULL);
+	assert(chunk_size > 0);
+
+	struct stat info;
+	bool direct;
+
+	*stream = (MemoryArenaFileStream){0};
+	stream->fd = __memory_arena_file_open(path, flags, &direct);
+
+	if (stream->fd < 0)
+		return false;
+
+	if (fstat(stream->fd, &info) != 0)
+	{
+		close(stream->fd);
+		return false;
+	}
+
+	uintptr_t alignment = direct ? MEMORY_ARENA_FILE_DIRECT_ALIGNMENT : 16;
+
+	stream->direct = direct;
+	stream->file_size = (uintptr_t)info.st_size;
+	stream->chunk_size = direct ? __align_forward(chunk_size, alignment) : chunk_size;
+	stream->buffers[0] = memory_arena_push(arena, stream->chunk_size, alignment);
+	stream->buffers[1] = memory_arena_push(arena, stream->chunk_size, alignment);
+
+	if (stream->buffers[0] == NULL || stream->buffers[1] == NULL)
+	{
+		close(stream->fd);
+		return false;
+	}
+
+#ifdef MEMORY_ARENA_FILE_URING
+	if (!(flags & MEMORY_ARENA_FILE_NO_URING) && stream->file_size > stream->chunk_size)
+	{
+		MemoryArenaFileUring* ring = malloc(sizeof(MemoryArenaFileUring));
+
+		if (ring && __memory_arena_file_uring_init(ring, 2))
+		{
+			stream->uring = ring;
+			__memory_arena_file_stream_submit(stream);
+		}
+		else
+			free(ring);
+	}
+#endif
+
+	return true;
+}
+
+const void*
+memory_arena_file_stream_next(MemoryArenaFileStream* stream, uintptr_t* size)
+{
+	assert(stream != NULL);
+
+	if (size)
+		*size = 0;
+
+	if (stream->error != 0 || stream->offset >= stream->file_size)
+		return NULL;
+
+	uintptr_t index = stream->next_buffer;
+	uint8_t* buffer = stream->buffers[index];
+	uintptr_t want = __memory_arena_file_stream_chunk(stream);
+	uintptr_t length = stream->direct ? stream->chunk_size : want;
+	uintptr_t done = 0;
+
+#ifdef MEMORY_ARENA_FILE_URING
+	if (stream->in_flight)
+	{
+		int32_t result = __memory_arena_file_stream_wait(stream);
+
+		//NOTE: The read is over either way, pread may use the buffer for whatever is missing
+		if (result > 0)
+			done = (uintptr_t)result;
+		else if (result < 0 && result != -EINVAL && result != -EINTR && result != -EAGAIN)
+			stream->error = -result;
+	}
+#endif
+
+	//NOTE: Synchronous path, and the tail of a short asynchronous read
+	if (stream->error == 0 && done < want)
+		stream->error = __memory_arena_file_pread(stream->fd, buffer, length, want, stream->offset, &done);
+
+	if (stream->error != 0 || done == 0)
+		return NULL;
+
+	want = MIN(want, done);
+	stream->offset += want;
+	stream->next_buffer = index ^ 1;
+
+	//NOTE: Start the next chunk into the buffer the caller just gave back
+#ifdef MEMORY_ARENA_FILE_URING
+	if (stream->uring && stream->offset < stream->file_size)
+		__memory_arena_file_stream_submit(stream);
+#endif
+
+	if (size)
+		*size = want;
+
+	return buffer;
+}
+
+void
+memory_arena_file_stream_close(MemoryArenaFileStream* stream)
+{
+	assert(stream != NULL);
+
+#ifdef MEMORY_ARENA_FILE_URING
+	if (stream->uring)
+	{
+		//NOTE: The kernel may still be writing into arena memory
+		if (stream->in_flight)
+			__memory_arena_file_stream_wait(stream);
+		if (stream->uring)
+			__memory_arena_file_stream_drop_uring(stream);
+	}
+#endif
+
+	if (stream->fd >= 0)
+		close(stream->fd);
+
+	*stream = (MemoryArenaFileStream){0};
+	stream->fd = -1;
+}
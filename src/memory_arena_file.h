@@ -0,0 +1,81 @@
+
+#ifndef MEMORY_ARENA_FILE_H
+# define MEMORY_ARENA_FILE_H
+
+# include "memory_arena.h"
+# include <stdbool.h>
+
+/*
+| #MEMORY_ARENA_FILE
+|
+|| #READ_FILE(S) :IO_URING / PREAD
+|| [[FILE_BYTES]-[\0]-PADDING] (pushed straight into the arena, no copy)
+|
+|| #STREAM :DOUBLE_BUFFERED
+|| >buffers[2] (arena)
+|| >caller parses one while the next chunk is in flight
+|
+*/
+
+//NOTE: O_DIRECT needs buffers, offsets and lengths on this boundary
+# ifndef MEMORY_ARENA_FILE_DIRECT_ALIGNMENT
+#  define MEMORY_ARENA_FILE_DIRECT_ALIGNMENT 4096
+# endif
+
+//NOTE: Files read by one io_uring batch at a time
+# ifndef MEMORY_ARENA_FILE_QUEUE_DEPTH
+#  define MEMORY_ARENA_FILE_QUEUE_DEPTH 64
+# endif
+
+typedef enum
+{
+	MEMORY_ARENA_FILE_DIRECT = 1 << 0,  // bypass the page cache, silently buffered where unsupported
+	MEMORY_ARENA_FILE_NO_URING = 1 << 1,  // force the pread path
+}
+MemoryArenaFileFlags;
+
+typedef struct
+{
+	const char* path;
+	void* data;
+	uintptr_t size;
+	int error;
+	bool direct;  // really opened with O_DIRECT, data is then MEMORY_ARENA_FILE_DIRECT_ALIGNMENT aligned
+}
+MemoryArenaFile;
+
+typedef struct
+{
+	int fd;
+	uint8_t* buffers[2];
+	uintptr_t chunk_size;
+	uintptr_t file_size;
+	uintptr_t offset;
+	uintptr_t next_buffer;
+	int error;
+	bool direct;
+	bool in_flight;
+	void* uring;
+}
+MemoryArenaFileStream;
+
+
+//NOTE: The data is NUL terminated, size does not count the terminator
+void*
+memory_arena_read_file(MemoryArena* arena, const char* path, uintptr_t* size, uint32_t flags);
+
+//NOTE: Fills data/size/error of every entry, returns false when any of them failed
+bool
+memory_arena_read_files(MemoryArena* arena, MemoryArenaFile* files, uintptr_t count, uint32_t flags);
+
+bool
+memory_arena_file_stream_open(MemoryArenaFileStream* stream, MemoryArena* arena, const char* path, uintptr_t chunk_size, uint32_t flags);
+
+//NOTE: The previous chunk is reused once this is called, returns NULL at the end of the file or on error
+const void*
+memory_arena_file_stream_next(MemoryArenaFileStream* stream, uintptr_t* size);
+
+void
+memory_arena_file_stream_close(MemoryArenaFileStream* stream);
+
+#endif
@@ -0,0 +1,258 @@
+
+#include "memory_arena_intern.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+//NOTE: wyhash (final v4), reads 8/16 bytes per step and mixes with 64x64->128 multiplies
+static const uint64_t __wyp[4] = {
+	0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+};
+
+static inline
+void
+__wymum(uint64_t* a, uint64_t* b)
+{
+#if defined(__SIZEOF_INT128__)
+	__extension__ unsigned __int128 r = (unsigned __int128)*a * *b;
+
+	*a = (uint64_t)r;
+	*b = (uint64_t)(r >> 64);
+#else
+	uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	uint64_t t = rl + (rm0 << 32);
+	uint64_t c = t < rl;
+	uint64_t lo = t + (rm1 << 32);
+
+	c += lo < t;
+	*a = lo;
+	*b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline
+uint64_t
+__wymix(uint64_t a, uint64_t b)
+{
+	__wymum(&a, &b);
+	return a ^ b;
+}
+
+static inline
+uint64_t
+__wyr8(const uint8_t* p)
+{
+	uint64_t v;
+	memcpy(&v, p, 8);
+	return v;
+}
+
+static inline
+uint64_t
+__wyr4(const uint8_t* p)
+{
+	uint32_t v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+static inline
+uint64_t
+__wyr3(const uint8_t* p, uintptr_t k)
+{
+	return (((uint64_t)p[0]) << 16) | (((uint64_t)p[k >> 1]) << 8) | p[k - 1];
+}
+
+uint64_t
+memory_arena_hash(const void* data, uintptr_t length, uint64_t seed)
+{
+	const uint8_t* p = data;
+	uint64_t a, b;
+
+	seed ^= __wymix(seed ^ __wyp[0], __wyp[1]);
+
+	if (length <= 16)
+	{
+		if (length >= 4)
+		{
+			a = (__wyr4(p) << 32) | __wyr4(p + ((length >> 3) << 2));
+			b = (__wyr4(p + length - 4) << 32) | __wyr4(p + length - 4 - ((length >> 3) << 2));
+		}
+		else if (length > 0)
+		{
+			a = __wyr3(p, length);
+			b = 0;
+		}
+		else
+			a = b = 0;
+	}
+	else
+	{
+		uintptr_t i = length;
+
+		if (i > 48)
+		{
+			uint64_t see1 = seed, see2 = seed;
+
+			do
+			{
+				seed = __wymix(__wyr8(p) ^ __wyp[1], __wyr8(p + 8) ^ seed);
+				see1 = __wymix(__wyr8(p + 16) ^ __wyp[2], __wyr8(p + 24) ^ see1);
+				see2 = __wymix(__wyr8(p + 32) ^ __wyp[3], __wyr8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			}
+			while (i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16)
+		{
+			seed = __wymix(__wyr8(p) ^ __wyp[1], __wyr8(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+		a = __wyr8(p + i - 16);
+		b = __wyr8(p + i - 8);
+	}
+
+	a ^= __wyp[1];
+	b ^= seed;
+	__wymum(&a, &b);
+
+	return __wymix(a ^ __wyp[0] ^ length, b ^ __wyp[1]);
+}
+
+void
+memory_arena_intern_init(MemoryArenaInternTable* table, MemoryArena* arena, uintptr_t capacity)
+{
+	assert(table != NULL);
+	assert(arena != NULL);
+
+	uintptr_t slot_capacity = 16;
+
+	//NOTE: Keep the load factor under 3/4
+	while (slot_capacity - slot_capacity / 4 < capacity)
+		slot_capacity *= 2;
+
+	*table = (MemoryArenaInternTable){0};
+	table->arena = arena;
+	table->minimum_slot_capacity = slot_capacity;
+}
+
+void
+memory_arena_intern_clear(MemoryArenaInternTable* table)
+{
+	assert(table != NULL);
+
+	table->slots = NULL;
+	table->slot_capacity = 0;
+	table->count = 0;
+}
+
+static inline
+MemoryArenaInternSlot*
+__memory_arena_intern_probe(MemoryArenaInternSlot* slots, uintptr_t slot_capacity, uint64_t hash, const char* string, uintptr_t length)
+{
+	uintptr_t mask = slot_capacity - 1;
+	uintptr_t index = (uintptr_t)hash & mask;
+
+	while (slots[index].string != NULL)
+	{
+		MemoryArenaInternSlot* slot = &slots[index];
+
+		if (slot->hash == hash
+			&& memory_arena_interned_length(slot->string) == length
+			&& (length == 0 || memcmp(slot->string, string, length) == 0))
+			return slot;
+
+		index = (index + 1) & mask;
+	}
+
+	return &slots[index];
+}
+
+static inline
+bool
+__memory_arena_intern_grow(MemoryArenaInternTable* table)
+{
+	uintptr_t slot_capacity = MAX(table->slot_capacity * 2, table->minimum_slot_capacity);
+	MemoryArenaInternSlot* slots = memory_arena_alloc_array(table->arena, MemoryArenaInternSlot, slot_capacity);
+
+	if (slots == NULL)
+		return false;
+
+	memset(slots, 0, sizeof(MemoryArenaInternSlot) * slot_capacity);
+
+	//NOTE: The old slot array is left behind in the arena
+	for (uintptr_t i = 0; i < table->slot_capacity; i++)
+	{
+		MemoryArenaInternSlot* slot = &table->slots[i];
+		uintptr_t index = (uintptr_t)slot->hash & (slot_capacity - 1);
+
+		if (slot->string == NULL)
+			continue;
+
+		while (slots[index].string != NULL)
+			index = (index + 1) & (slot_capacity - 1);
+		slots[index] = *slot;
+	}
+
+	table->slots = slots;
+	table->slot_capacity = slot_capacity;
+
+	return true;
+}
+
+const char*
+memory_arena_intern_find(MemoryArenaInternTable* table, const char* string, uintptr_t length)
+{
+	assert(table != NULL);
+	assert(string != NULL || length == 0);
+
+	if (table->slots == NULL)
+		return NULL;
+
+	uint64_t hash = memory_arena_hash(string, length, table->seed);
+
+	return __memory_arena_intern_probe(table->slots, table->slot_capacity, hash, string, length)->string;
+}
+
+const char*
+memory_arena_intern(MemoryArenaInternTable* table, const char* string, uintptr_t length)
+{
+	assert(table != NULL);
+	assert(string != NULL || length == 0);
+
+	if (table->count + 1 > table->slot_capacity - table->slot_capacity / 4)
+	{
+		if (!__memory_arena_intern_grow(table))
+			return NULL;
+	}
+
+	uint64_t hash = memory_arena_hash(string, length, table->seed);
+	MemoryArenaInternSlot* slot = __memory_arena_intern_probe(table->slots, table->slot_capacity, hash, string, length);
+
+	if (slot->string != NULL)
+		return slot->string;
+
+	MemoryArenaInternHeader* header = memory_arena_push(table->arena,
+		sizeof(MemoryArenaInternHeader) + length + 1, _Alignof(MemoryArenaInternHeader));
+
+	if (header == NULL)
+		return NULL;
+
+	char* bytes = (char*)(header + 1);
+
+	header->hash = hash;
+	header->length = length;
+	if (length > 0)
+		memcpy(bytes, string, length);
+	bytes[length] = '\0';
+
+	slot->hash = hash;
+	slot->string = bytes;
+	table->count++;
+
+	return bytes;
+}
@@ -0,0 +1,71 @@
+
+#ifndef MEMORY_ARENA_INTERN_H
+# define MEMORY_ARENA_INTERN_H
+
+# include "memory_arena.h"
+# include <string.h>
+
+/*
+| #MEMORY_ARENA_INTERN
+|
+|| #SLOTS :OPEN_ADDRESSING
+|| >hash
+|| >string
+|
+|| #STRING :ARENA
+|| [HEADER]-[BYTES]-[\0]
+|
+| >slot_capacity
+| >count
+|
+*/
+
+typedef struct
+{
+	uint64_t hash;
+	uintptr_t length;
+	//NOTE: The string bytes are right behind this struct, NUL terminated
+	//	[[HEADER]-[BYTES]-[\0]]
+}
+MemoryArenaInternHeader;
+
+typedef struct
+{
+	uint64_t hash;
+	const char* string;
+}
+MemoryArenaInternSlot;
+
+typedef struct
+{
+	MemoryArena* arena;
+	MemoryArenaInternSlot* slots;
+	uintptr_t slot_capacity;
+	uintptr_t minimum_slot_capacity;
+	uintptr_t count;
+	uint64_t seed;
+}
+MemoryArenaInternTable;
+
+
+uint64_t
+memory_arena_hash(const void* data, uintptr_t length, uint64_t seed);
+
+void
+memory_arena_intern_init(MemoryArenaInternTable* table, MemoryArena* arena, uintptr_t capacity);
+
+//NOTE: Call after clearing the backing arena, the strings and slots went with it
+void
+memory_arena_intern_clear(MemoryArenaInternTable* table);
+
+const char*
+memory_arena_intern(MemoryArenaInternTable* table, const char* string, uintptr_t length);
+
+const char*
+memory_arena_intern_find(MemoryArenaInternTable* table, const char* string, uintptr_t length);
+
+# define memory_arena_intern_cstr(TABLE, STRING) memory_arena_intern(TABLE, STRING, strlen(STRING))
+# define memory_arena_interned_header(STRING) ((const MemoryArenaInternHeader*)(STRING) - 1)
+# define memory_arena_interned_length(STRING) (memory_arena_interned_header(STRING)->length)
+
+#endif
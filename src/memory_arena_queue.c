@@ -0,0 +1,246 @@
+
+#include "memory_arena_queue.h"
+#include <stdlib.h>
+#include <assert.h>
+
+void
+memory_arena_queue_init(MemoryArenaQueue* queue)
+{
+	assert(queue != NULL);
+
+	queue->stub = (MemoryArenaQueueMessage){0};
+	atomic_init(&queue->stub.next, NULL);
+	atomic_init(&queue->head, &queue->stub);
+	queue->tail = &queue->stub;
+}
+
+void
+memory_arena_queue_producer_init(MemoryArenaQueueProducer* producer, MemoryArenaQueue* queue, uintptr_t minimum_block_capacity)
+{
+	assert(producer != NULL);
+	assert(queue != NULL);
+	assert(minimum_block_capacity > 0);
+
+	*producer = (MemoryArenaQueueProducer){0};
+	producer->queue = queue;
+	producer->minimum_block_capacity = minimum_block_capacity;
+	memory_arena_init(&producer->arena,
+		(sizeof(MemoryArenaQueueBlock) + minimum_block_capacity) * MEMORY_ARENA_QUEUE_BLOCKS_PER_ARENA_BLOCK);
+	atomic_init(&producer->returned_blocks, NULL);
+}
+
+static inline
+void
+__memory_arena_queue_block_release(MemoryArenaQueueBlock* block)
+{
+	//NOTE: Last reference hands the block back to its producer
+	if (atomic_fetch_sub_explicit(&block->ref_count, 1, memory_order_acq_rel) != 1)
+		return;
+
+	MemoryArenaQueueProducer* producer = block->producer;
+	MemoryArenaBlockFooter* head = atomic_load_explicit(&producer->returned_blocks, memory_order_relaxed);
+
+	do
+	{
+		block->footer.next = head;
+	}
+	while (!atomic_compare_exchange_weak_explicit(&producer->returned_blocks, &head, &block->footer,
+		memory_order_release, memory_order_relaxed));
+}
+
+static inline
+void
+__memory_arena_queue_collect_returned(MemoryArenaQueueProducer* producer)
+{
+	MemoryArenaBlockFooter* returned = atomic_exchange_explicit(&producer->returned_blocks, NULL, memory_order_acquire);
+
+	while (returned)
+	{
+		MemoryArenaBlockFooter* next = returned->next;
+
+		returned->next = producer->free_blocks;
+		producer->free_blocks = returned;
+		returned = next;
+	}
+}
+
+bool
+memory_arena_queue_producer_destroy(MemoryArenaQueueProducer* producer)
+{
+	assert(producer != NULL);
+
+	if (producer->block)
+		__memory_arena_queue_block_release(producer->block);
+	producer->block = NULL;
+
+	__memory_arena_queue_collect_returned(producer);
+
+	uintptr_t free_count = 0;
+
+	for (MemoryArenaBlockFooter* block = producer->free_blocks; block; block = block->next)
+		free_count++;
+
+	//NOTE: A consumer still reads from a block, the producer stays usable
+	if (free_count != producer->block_count)
+		return false;
+
+	memory_arena_destroy(&producer->arena);
+	producer->free_blocks = NULL;
+	producer->block_count = 0;
+
+	return true;
+}
+
+static inline
+MemoryArenaQueueBlock*
+__memory_arena_queue_new_block(MemoryArenaQueueProducer* producer, uintptr_t init_size, uintptr_t alignment)
+{
+	uintptr_t size = sizeof(MemoryArenaQueueMessage) + init_size + alignment - 1;
+	uintptr_t block_size = MAX(producer->minimum_block_capacity, sizeof(MemoryArenaQueueBlock) + size);
+
+	if (producer->free_blocks == NULL)
+		__memory_arena_queue_collect_returned(producer);
+
+	//NOTE: First recycled block big enough, smaller ones stay for smaller messages
+	MemoryArenaBlockFooter** link = &producer->free_blocks;
+
+	while (*link && (*link)->capacity < size)
+		link = &(*link)->next;
+
+	MemoryArenaQueueBlock* block = (MemoryArenaQueueBlock*)*link;
+
+	if (block != NULL)
+		*link = block->footer.next;
+	else
+	{
+		block = memory_arena_push(&producer->arena, block_size, _Alignof(MemoryArenaQueueBlock));
+		if (block == NULL)
+			return NULL;
+
+		block->footer.capacity = block_size - sizeof(MemoryArenaQueueBlock);
+		block->footer.serial = 0;
+		block->producer = producer;
+		producer->block_count++;
+	}
+
+	block->footer.next = NULL;
+	block->footer.top = 0;
+	//NOTE: The producer holds one reference for as long as the block is current
+	atomic_init(&block->ref_count, 1);
+
+	return block;
+}
+
+void*
+memory_arena_queue_push(MemoryArenaQueueProducer* producer, uintptr_t size, uintptr_t alignment)
+{
+	assert(producer != NULL);
+	assert(alignment > 0);
+	assert((alignment & (alignment - 1)) == 0);
+
+	alignment = MAX(alignment, _Alignof(MemoryArenaQueueMessage));
+
+	MemoryArenaQueueBlock* block = producer->block;
+	uintptr_t payload_addr = 0;
+
+	if (block != NULL)
+	{
+		uintptr_t current_addr = (uintptr_t)(block + 1) + block->footer.top;
+
+		payload_addr = __align_forward(current_addr + sizeof(MemoryArenaQueueMessage), alignment);
+		if (payload_addr + size - (uintptr_t)(block + 1) > block->footer.capacity)
+		{
+			__memory_arena_queue_block_release(block);
+			block = NULL;
+		}
+	}
+
+	if (block == NULL)
+	{
+		block = __memory_arena_queue_new_block(producer, size, alignment);
+		producer->block = block;
+		if (block == NULL)
+			return NULL;
+
+		payload_addr = __align_forward((uintptr_t)(block + 1) + sizeof(MemoryArenaQueueMessage), alignment);
+	}
+
+	block->footer.top = payload_addr + size - (uintptr_t)(block + 1);
+	atomic_fetch_add_explicit(&block->ref_count, 1, memory_order_relaxed);
+
+	MemoryArenaQueueMessage* message = (MemoryArenaQueueMessage*)payload_addr - 1;
+
+	atomic_init(&message->next, NULL);
+	message->block = block;
+	message->size = size;
+
+	return (void*)payload_addr;
+}
+
+static inline
+void
+__memory_arena_queue_enqueue(MemoryArenaQueue* queue, MemoryArenaQueueMessage* message)
+{
+	atomic_store_explicit(&message->next, NULL, memory_order_relaxed);
+
+	MemoryArenaQueueMessage* prev = atomic_exchange_explicit(&queue->head, message, memory_order_acq_rel);
+
+	atomic_store_explicit(&prev->next, message, memory_order_release);
+}
+
+void
+memory_arena_queue_publish(MemoryArenaQueueProducer* producer, void* payload)
+{
+	assert(producer != NULL);
+	assert(payload != NULL);
+	assert(memory_arena_queue_message(payload)->block->producer == producer);
+
+	__memory_arena_queue_enqueue(producer->queue, memory_arena_queue_message(payload));
+}
+
+void*
+memory_arena_queue_pop(MemoryArenaQueue* queue, uintptr_t* size)
+{
+	assert(queue != NULL);
+
+	//NOTE: Intrusive MPSC queue (Vyukov), the stub keeps the list non-empty
+	MemoryArenaQueueMessage* tail = queue->tail;
+	MemoryArenaQueueMessage* next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+	if (tail == &queue->stub)
+	{
+		if (next == NULL)
+			return NULL;
+
+		queue->tail = next;
+		tail = next;
+		next = atomic_load_explicit(&tail->next, memory_order_acquire);
+	}
+
+	if (next == NULL)
+	{
+		//NOTE: A producer is between its exchange and its link, try again later
+		if (tail != atomic_load_explicit(&queue->head, memory_order_acquire))
+			return NULL;
+
+		__memory_arena_queue_enqueue(queue, &queue->stub);
+		next = atomic_load_explicit(&tail->next, memory_order_acquire);
+		if (next == NULL)
+			return NULL;
+	}
+
+	queue->tail = next;
+
+	if (size)
+		*size = tail->size;
+
+	return tail + 1;
+}
+
+void
+memory_arena_queue_release(void* payload)
+{
+	assert(payload != NULL);
+
+	__memory_arena_queue_block_release(memory_arena_queue_message(payload)->block);
+}
@@ -0,0 +1,100 @@
+
+#ifndef MEMORY_ARENA_QUEUE_H
+# define MEMORY_ARENA_QUEUE_H
+
+# include "memory_arena.h"
+# include <stdatomic.h>
+# include <stdbool.h>
+
+/*
+| #MEMORY_ARENA_QUEUE :MPSC
+|
+|| #PRODUCER :ONE_PER_THREAD
+|| >arena (queue blocks are pushed here, only the producer thread touches it)
+|| >block (current)
+|| >free_blocks (producer side)
+|| >returned_blocks (consumer side)
+|
+||| #BLOCK :REFERENCE_COUNTED
+||| [[FOOTER]-[MESSAGE]-[PAYLOAD]-[MESSAGE]-[PAYLOAD]...]
+|
+| >head (producers)
+| >tail (consumer)
+|
+*/
+
+//NOTE: Queue blocks carved out of one block of the producer arena
+# ifndef MEMORY_ARENA_QUEUE_BLOCKS_PER_ARENA_BLOCK
+#  define MEMORY_ARENA_QUEUE_BLOCKS_PER_ARENA_BLOCK 8
+# endif
+
+typedef struct MemoryArenaQueueProducer MemoryArenaQueueProducer;
+
+typedef struct MemoryArenaQueueBlock
+{
+	MemoryArenaBlockFooter footer;
+	MemoryArenaQueueProducer* producer;
+	atomic_uintptr_t ref_count;
+	//NOTE: The raw data is right behind this struct in one allocated space
+	//	[[BLOCK]-PADDING-[RAW_DATA]]
+}
+MemoryArenaQueueBlock;
+
+typedef struct MemoryArenaQueueMessage
+{
+	struct MemoryArenaQueueMessage* _Atomic next;
+	MemoryArenaQueueBlock* block;
+	uintptr_t size;
+	//NOTE: The payload is right behind this struct, aligned as requested
+}
+MemoryArenaQueueMessage;
+
+typedef struct
+{
+	MemoryArenaQueueMessage* _Atomic head;
+	MemoryArenaQueueMessage* tail;
+	MemoryArenaQueueMessage stub;
+}
+MemoryArenaQueue;
+
+struct MemoryArenaQueueProducer
+{
+	MemoryArenaQueue* queue;
+	//NOTE: Queue blocks are recycled through the lists below, never given back before destroy
+	MemoryArena arena;
+	MemoryArenaQueueBlock* block;
+	MemoryArenaBlockFooter* free_blocks;
+	MemoryArenaBlockFooter* _Atomic returned_blocks;
+	uintptr_t minimum_block_capacity;
+	uintptr_t block_count;
+};
+
+
+void
+memory_arena_queue_init(MemoryArenaQueue* queue);
+
+void
+memory_arena_queue_producer_init(MemoryArenaQueueProducer* producer, MemoryArenaQueue* queue, uintptr_t minimum_block_capacity);
+
+//NOTE: Returns false and frees nothing while messages of this producer are still held,
+//	call it again once they are released
+bool
+memory_arena_queue_producer_destroy(MemoryArenaQueueProducer* producer);
+
+void*
+memory_arena_queue_push(MemoryArenaQueueProducer* producer, uintptr_t size, uintptr_t alignment);
+
+void
+memory_arena_queue_publish(MemoryArenaQueueProducer* producer, void* payload);
+
+//NOTE: Single consumer, returns NULL when empty
+void*
+memory_arena_queue_pop(MemoryArenaQueue* queue, uintptr_t* size);
+
+void
+memory_arena_queue_release(void* payload);
+
+# define memory_arena_queue_alloc(PRODUCER, TYPE) (TYPE*)memory_arena_queue_push(PRODUCER, sizeof(TYPE), _Alignof(TYPE))
+# define memory_arena_queue_message(PAYLOAD) ((MemoryArenaQueueMessage*)(PAYLOAD) - 1)
+
+#endif
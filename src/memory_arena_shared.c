@@ -0,0 +1,239 @@
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+# define _GNU_SOURCE
+#endif
+
+#include "memory_arena_shared.h"
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//NOTE: First byte handed out, keeps offset 0 free for MEMORY_ARENA_SHARED_NULL
+#define MEMORY_ARENA_SHARED_DATA_OFFSET __align_forward(sizeof(MemoryArenaSharedHeader), 64)
+
+static inline
+bool
+__memory_arena_shared_map(MemoryArenaShared* shared, int fd, uintptr_t size, bool writer)
+{
+	int protection = writer ? PROT_READ | PROT_WRITE : PROT_READ;
+	void* base = mmap(NULL, size, protection, MAP_SHARED, fd, 0);
+
+	if (base == MAP_FAILED)
+		return false;
+
+	*shared = (MemoryArenaShared){0};
+	shared->header = base;
+	shared->base = base;
+	shared->size = size;
+	shared->top = MEMORY_ARENA_SHARED_DATA_OFFSET;
+	shared->fd = fd;
+	shared->writer = writer;
+
+	return true;
+}
+
+bool
+memory_arena_shared_create(MemoryArenaShared* shared, const char* name, uintptr_t capacity)
+{
+	assert(shared != NULL);
+	assert(capacity > 0);
+
+	uintptr_t size = MEMORY_ARENA_SHARED_DATA_OFFSET + capacity;
+	int fd = -1;
+
+	if (name)
+		fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	else
+	{
+#if defined(__linux__)
+		fd = memfd_create("memory_arena_shared", MFD_CLOEXEC);
+#endif
+	}
+
+	if (fd < 0)
+		return false;
+
+	if (ftruncate(fd, (off_t)size) != 0 || !__memory_arena_shared_map(shared, fd, size, true))
+	{
+		close(fd);
+		if (name)
+			shm_unlink(name);
+		return false;
+	}
+
+	shared->header->magic = MEMORY_ARENA_SHARED_MAGIC;
+	shared->header->capacity = capacity;
+	atomic_store_explicit(&shared->header->published_top, shared->top, memory_order_relaxed);
+	atomic_store_explicit(&shared->header->published_root, MEMORY_ARENA_SHARED_NULL, memory_order_relaxed);
+	atomic_store_explicit(&shared->header->generation, 0, memory_order_release);
+
+	return true;
+}
+
+bool
+memory_arena_shared_open_fd(MemoryArenaShared* shared, int fd)
+{
+	assert(shared != NULL);
+
+	struct stat info;
+
+	if (fstat(fd, &info) != 0 || (uintptr_t)info.st_size < MEMORY_ARENA_SHARED_DATA_OFFSET)
+		return false;
+
+	if (!__memory_arena_shared_map(shared, fd, (uintptr_t)info.st_size, false))
+		return false;
+
+	if (shared->header->magic != MEMORY_ARENA_SHARED_MAGIC
+		|| MEMORY_ARENA_SHARED_DATA_OFFSET + shared->header->capacity > shared->size)
+	{
+		munmap(shared->base, shared->size);
+		*shared = (MemoryArenaShared){0};
+		return false;
+	}
+
+	return true;
+}
+
+bool
+memory_arena_shared_open(MemoryArenaShared* shared, const char* name)
+{
+	assert(shared != NULL);
+	assert(name != NULL);
+
+	int fd = shm_open(name, O_RDONLY, 0);
+
+	if (fd < 0)
+		return false;
+
+	if (!memory_arena_shared_open_fd(shared, fd))
+	{
+		close(fd);
+		return false;
+	}
+
+	return true;
+}
+
+void
+memory_arena_shared_close(MemoryArenaShared* shared)
+{
+	assert(shared != NULL);
+
+	if (shared->base)
+	{
+		munmap(shared->base, shared->size);
+		close(shared->fd);
+	}
+
+	*shared = (MemoryArenaShared){0};
+}
+
+void
+memory_arena_shared_unlink(const char* name)
+{
+	assert(name != NULL);
+
+	shm_unlink(name);
+}
+
+void*
+memory_arena_shared_push(MemoryArenaShared* shared, uintptr_t size, uintptr_t alignment)
+{
+	assert(shared != NULL);
+	assert(shared->writer);
+	assert(alignment > 0);
+	assert((alignment & (alignment - 1)) == 0);
+
+	//NOTE: Alignment is relative to the mapping so it holds in every process (mmap is page aligned)
+	uintptr_t offset = __align_forward(shared->top, alignment);
+
+	if (offset + size > shared->size || offset + size < offset)
+		return NULL;
+
+	shared->top = offset + size;
+
+	return shared->base + offset;
+}
+
+void
+memory_arena_shared_publish(MemoryArenaShared* shared, MemoryArenaSharedOffset root)
+{
+	assert(shared != NULL);
+	assert(shared->writer);
+	assert(root < shared->top);
+
+	uint64_t generation = atomic_load_explicit(&shared->header->generation, memory_order_relaxed);
+
+	//NOTE: Stored top first, readers load in the opposite order so a root is always under its top
+	atomic_store_explicit(&shared->header->published_top, shared->top, memory_order_release);
+	atomic_store_explicit(&shared->header->published_root, root, memory_order_release);
+	//NOTE: Next even value, ends the write started by a reset
+	atomic_store_explicit(&shared->header->generation, (generation | 1) + 1, memory_order_release);
+}
+
+void
+memory_arena_shared_reset(MemoryArenaShared* shared)
+{
+	assert(shared != NULL);
+	assert(shared->writer);
+
+	uint64_t generation = atomic_load_explicit(&shared->header->generation, memory_order_relaxed);
+
+	//NOTE: Odd until the next publish, the fence keeps the rewrites of the region after it
+	if ((generation & 1) == 0)
+		atomic_store_explicit(&shared->header->generation, generation + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	shared->top = MEMORY_ARENA_SHARED_DATA_OFFSET;
+	atomic_store_explicit(&shared->header->published_root, MEMORY_ARENA_SHARED_NULL, memory_order_relaxed);
+	atomic_store_explicit(&shared->header->published_top, shared->top, memory_order_relaxed);
+}
+
+uint64_t
+memory_arena_shared_published(MemoryArenaShared* shared, MemoryArenaSharedOffset* root, uintptr_t* top)
+{
+	assert(shared != NULL);
+
+	uint64_t generation = atomic_load_explicit(&shared->header->generation, memory_order_acquire);
+	MemoryArenaSharedOffset published_root = atomic_load_explicit(&shared->header->published_root, memory_order_acquire);
+	uint64_t published_top = atomic_load_explicit(&shared->header->published_top, memory_order_acquire);
+
+	if (root)
+		*root = published_root;
+	if (top)
+		*top = (uintptr_t)published_top;
+
+	return generation;
+}
+
+bool
+memory_arena_shared_validate(MemoryArenaShared* shared, uint64_t generation)
+{
+	assert(shared != NULL);
+
+	//NOTE: Keeps the reads of the published data before the reload
+	atomic_thread_fence(memory_order_acquire);
+
+	return (generation & 1) == 0 && atomic_load_explicit(&shared->header->generation, memory_order_relaxed) == generation;
+}
+
+void*
+memory_arena_shared_resolve(MemoryArenaShared* shared, MemoryArenaSharedOffset offset, uintptr_t size, uintptr_t alignment)
+{
+	assert(shared != NULL);
+	assert(alignment > 0);
+	assert((alignment & (alignment - 1)) == 0);
+
+	//NOTE: Written so that a garbage offset or size can not overflow
+	if (offset < MEMORY_ARENA_SHARED_DATA_OFFSET || offset > shared->size || size > shared->size - offset)
+		return NULL;
+
+	uint8_t* pointer = shared->base + offset;
+
+	if ((uintptr_t)pointer & (alignment - 1))
+		return NULL;
+
+	return pointer;
+}
@@ -0,0 +1,105 @@
+
+#ifndef MEMORY_ARENA_SHARED_H
+# define MEMORY_ARENA_SHARED_H
+
+# include "memory_arena.h"
+# include <stdatomic.h>
+# include <stdbool.h>
+
+/*
+| #MEMORY_ARENA_SHARED :ONE_MAPPING_PER_PROCESS
+|
+|| #REGION :SHM / MEMFD
+|| [[HEADER]-PADDING-[RAW_DATA]]
+||
+|| #HEADER
+|| >magic
+|| >capacity
+|| >published_top (readers)
+|| >published_root (readers)
+|| >generation (readers, odd while the writer rewrites)
+|
+| >base (differs per process, only offsets are shared)
+| >top (writer, not yet published)
+|
+*/
+
+# define MEMORY_ARENA_SHARED_MAGIC 0x4D454D4152454E41ull
+# define MEMORY_ARENA_SHARED_NULL 0
+
+typedef uint64_t MemoryArenaSharedOffset;
+
+typedef struct
+{
+	uint64_t magic;
+	uint64_t capacity;
+	_Atomic uint64_t published_top;
+	_Atomic uint64_t published_root;
+	_Atomic uint64_t generation;
+}
+MemoryArenaSharedHeader;
+
+typedef struct
+{
+	MemoryArenaSharedHeader* header;
+	uint8_t* base;
+	uintptr_t size;
+	uintptr_t top;
+	int fd;
+	bool writer;
+}
+MemoryArenaShared;
+
+
+//NOTE: A NULL name gives an anonymous memfd, share it through fork or fd passing
+bool
+memory_arena_shared_create(MemoryArenaShared* shared, const char* name, uintptr_t capacity);
+
+bool
+memory_arena_shared_open(MemoryArenaShared* shared, const char* name);
+
+//NOTE: Takes ownership of fd on success only, memory_arena_shared_close() closes it then.
+//	On failure the caller still owns fd and has to close it.
+bool
+memory_arena_shared_open_fd(MemoryArenaShared* shared, int fd);
+
+void
+memory_arena_shared_close(MemoryArenaShared* shared);
+
+void
+memory_arena_shared_unlink(const char* name);
+
+void*
+memory_arena_shared_push(MemoryArenaShared* shared, uintptr_t size, uintptr_t alignment);
+
+void
+memory_arena_shared_publish(MemoryArenaShared* shared, MemoryArenaSharedOffset root);
+
+//NOTE: Starts a write, the generation stays odd until the next publish
+void
+memory_arena_shared_reset(MemoryArenaShared* shared);
+
+//NOTE: Returns the generation, it changes with every publish. Seqlock style reading:
+//	generation = published(), copy out what is needed, then validate(generation),
+//	and start over when it fails, the writer may have reset the region meanwhile.
+//	Until validated any offset may be torn, follow them with memory_arena_shared_resolve().
+uint64_t
+memory_arena_shared_published(MemoryArenaShared* shared, MemoryArenaSharedOffset* root, uintptr_t* top);
+
+//NOTE: True when the data read since memory_arena_shared_published() belongs to that generation
+bool
+memory_arena_shared_validate(MemoryArenaShared* shared, uint64_t generation);
+
+//NOTE: Checked memory_arena_shared_pointer for readers, NULL unless [offset, offset + size)
+//	is inside the data of this mapping and aligned
+void*
+memory_arena_shared_resolve(MemoryArenaShared* shared, MemoryArenaSharedOffset offset, uintptr_t size, uintptr_t alignment);
+
+# define memory_arena_shared_alloc(SHARED, TYPE) (TYPE*)memory_arena_shared_push(SHARED, sizeof(TYPE), _Alignof(TYPE))
+# define memory_arena_shared_alloc_array(SHARED, TYPE, COUNT) (TYPE*)memory_arena_shared_push(SHARED, sizeof(TYPE) * (COUNT), _Alignof(TYPE))
+# define memory_arena_shared_offset(SHARED, PTR) ((PTR) ? (MemoryArenaSharedOffset)((uint8_t*)(PTR) - (SHARED)->base) : MEMORY_ARENA_SHARED_NULL)
+# define memory_arena_shared_pointer(SHARED, OFFSET, TYPE) ((OFFSET) ? (TYPE*)((SHARED)->base + (OFFSET)) : (TYPE*)NULL)
+# define memory_arena_shared_resolve_type(SHARED, OFFSET, TYPE) (TYPE*)memory_arena_shared_resolve(SHARED, OFFSET, sizeof(TYPE), _Alignof(TYPE))
+# define memory_arena_shared_resolve_array(SHARED, OFFSET, TYPE, COUNT) (TYPE*)memory_arena_shared_resolve(SHARED, OFFSET, sizeof(TYPE) * (COUNT), _Alignof(TYPE))
+
+#endif
@@ -0,0 +1,252 @@
+
+#include "memory_arena_snapshot.h"
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#define MEMORY_ARENA_SNAPSHOT_PAGE_STRIDE \
+	__align_forward(sizeof(MemoryArenaSnapshotPage) + MEMORY_ARENA_SNAPSHOT_PAGE_SIZE, _Alignof(MemoryArenaSnapshotPage))
+
+static inline
+uintptr_t
+__memory_arena_snapshot_word_count(uintptr_t top)
+{
+	uintptr_t page_count = (top + MEMORY_ARENA_SNAPSHOT_PAGE_SIZE - 1) / MEMORY_ARENA_SNAPSHOT_PAGE_SIZE;
+
+	return (page_count + 63) / 64;
+}
+
+void
+memory_arena_snapshot_init(MemoryArenaSnapshot* snapshot)
+{
+	assert(snapshot != NULL);
+
+	*snapshot = (MemoryArenaSnapshot){0};
+}
+
+void
+memory_arena_snapshot_destroy(MemoryArenaSnapshot* snapshot)
+{
+	assert(snapshot != NULL);
+
+	free(snapshot->storage);
+	free(snapshot->pages);
+	*snapshot = (MemoryArenaSnapshot){0};
+}
+
+bool
+memory_arena_snapshot(MemoryArenaSnapshot* snapshot, MemoryArena* arena)
+{
+	assert(snapshot != NULL);
+	assert(arena != NULL);
+
+	uintptr_t block_count = 0;
+	uintptr_t word_count = 0;
+
+	for (MemoryArenaBlockFooter* block = arena->head_block; block; block = block->next)
+	{
+		block_count++;
+		word_count += __memory_arena_snapshot_word_count(block->top);
+	}
+
+	uintptr_t storage_size = sizeof(MemoryArenaSnapshotBlock) * block_count + sizeof(uint64_t) * word_count;
+
+	//NOTE: Only grows, a capture every frame should not hit malloc
+	if (storage_size > snapshot->storage_capacity)
+	{
+		void* storage = malloc(storage_size);
+
+		if (storage == NULL)
+			return false;
+
+		free(snapshot->storage);
+		snapshot->storage = storage;
+		snapshot->storage_capacity = storage_size;
+	}
+
+	MemoryArenaSnapshotBlock* blocks = snapshot->storage;
+	uint64_t* dirty = (uint64_t*)(blocks + block_count);
+	uintptr_t i = 0;
+
+	//NOTE: No arena bytes are copied here, pages get saved when they are first marked
+	for (MemoryArenaBlockFooter* block = arena->head_block; block; block = block->next, i++)
+	{
+		uintptr_t block_word_count = __memory_arena_snapshot_word_count(block->top);
+
+		blocks[i].block = block;
+		blocks[i].serial = block->serial;
+		blocks[i].top = block->top;
+		blocks[i].dirty = dirty;
+
+		memset(dirty, 0, sizeof(uint64_t) * block_word_count);
+		dirty += block_word_count;
+	}
+
+	snapshot->arena = arena;
+	snapshot->head_block = arena->head_block;
+	snapshot->scope_count = arena->scope_count;
+	snapshot->rewind_count = arena->rewind_count;
+	snapshot->blocks = blocks;
+	snapshot->block_count = block_count;
+	snapshot->pages_size = 0;
+
+	return true;
+}
+
+static inline
+bool
+__memory_arena_snapshot_save_page(MemoryArenaSnapshot* snapshot, uintptr_t block_index, uintptr_t page_index)
+{
+	MemoryArenaSnapshotBlock* entry = &snapshot->blocks[block_index];
+	uintptr_t stride = MEMORY_ARENA_SNAPSHOT_PAGE_STRIDE;
+
+	if (snapshot->pages_size + stride > snapshot->pages_capacity)
+	{
+		uintptr_t capacity = MAX(snapshot->pages_capacity * 2, stride * 16);
+		uint8_t* pages = realloc(snapshot->pages, capacity);
+
+		if (pages == NULL)
+			return false;
+
+		snapshot->pages = pages;
+		snapshot->pages_capacity = capacity;
+	}
+
+	MemoryArenaSnapshotPage* page = (MemoryArenaSnapshotPage*)(snapshot->pages + snapshot->pages_size);
+	uintptr_t offset = page_index * MEMORY_ARENA_SNAPSHOT_PAGE_SIZE;
+
+	page->block_index = block_index;
+	page->page_index = page_index;
+	page->size = MIN(MEMORY_ARENA_SNAPSHOT_PAGE_SIZE, entry->top - offset);
+	memcpy(page + 1, (uint8_t*)(entry->block + 1) + offset, page->size);
+
+	snapshot->pages_size += stride;
+	entry->dirty[page_index / 64] |= (uint64_t)1 << (page_index % 64);
+
+	return true;
+}
+
+bool
+memory_arena_snapshot_mark_dirty(MemoryArenaSnapshot* snapshot, const void* ptr, uintptr_t size)
+{
+	assert(snapshot != NULL);
+
+	uintptr_t addr = (uintptr_t)ptr;
+
+	if (size == 0)
+		return true;
+
+	for (uintptr_t i = 0; i < snapshot->block_count; i++)
+	{
+		MemoryArenaSnapshotBlock* entry = &snapshot->blocks[i];
+		uintptr_t begin = (uintptr_t)(entry->block + 1);
+
+		//NOTE: Anything past the snapshot top is newer memory, it is dropped on restore anyway
+		if (addr < begin || addr >= begin + entry->top)
+			continue;
+
+		uintptr_t offset_begin = addr - begin;
+		uintptr_t offset_end = MIN(offset_begin + size, entry->top);
+		uintptr_t first_page = offset_begin / MEMORY_ARENA_SNAPSHOT_PAGE_SIZE;
+		uintptr_t last_page = (offset_end - 1) / MEMORY_ARENA_SNAPSHOT_PAGE_SIZE;
+
+		for (uintptr_t page = first_page; page <= last_page; page++)
+		{
+			if (entry->dirty[page / 64] & ((uint64_t)1 << (page % 64)))
+				continue;
+			if (!__memory_arena_snapshot_save_page(snapshot, i, page))
+				return false;
+		}
+
+		return true;
+	}
+
+	return true;
+}
+
+bool
+memory_arena_snapshot_mark_all_dirty(MemoryArenaSnapshot* snapshot)
+{
+	assert(snapshot != NULL);
+
+	for (uintptr_t i = 0; i < snapshot->block_count; i++)
+	{
+		MemoryArenaSnapshotBlock* entry = &snapshot->blocks[i];
+
+		if (!memory_arena_snapshot_mark_dirty(snapshot, entry->block + 1, entry->top))
+			return false;
+	}
+
+	return true;
+}
+
+static inline
+bool
+__memory_arena_snapshot_chain_alive(MemoryArenaSnapshot* snapshot)
+{
+	//NOTE: A rewind inside a captured block hands its bytes out again, marks never saw those writes
+	if (snapshot->arena->rewind_count != snapshot->rewind_count)
+		return false;
+
+	if (snapshot->block_count == 0)
+		return true;
+
+	//NOTE: Only live blocks are dereferenced, captured pointers are compared, never followed
+	MemoryArenaBlockFooter* block = snapshot->arena->head_block;
+
+	while (block && !(block == snapshot->blocks[0].block && block->serial == snapshot->blocks[0].serial))
+		block = block->next;
+
+	for (uintptr_t i = 0; i < snapshot->block_count; i++, block = block->next)
+	{
+		MemoryArenaSnapshotBlock* entry = &snapshot->blocks[i];
+
+		if (block != entry->block || block->serial != entry->serial)
+			return false;
+	}
+
+	return block == NULL;
+}
+
+bool
+memory_arena_restore(MemoryArenaSnapshot* snapshot)
+{
+	assert(snapshot != NULL);
+	assert(snapshot->arena != NULL);
+
+	MemoryArena* arena = snapshot->arena;
+
+	if (!__memory_arena_snapshot_chain_alive(snapshot))
+		return false;
+
+	//NOTE: Blocks created after the snapshot go away, same as ending a scope
+	while (arena->head_block != snapshot->head_block)
+	{
+		MemoryArenaBlockFooter* block = arena->head_block;
+
+		arena->head_block = block->next;
+		free(block);
+	}
+
+	for (uintptr_t i = 0; i < snapshot->block_count; i++)
+		snapshot->blocks[i].block->top = snapshot->blocks[i].top;
+
+	uintptr_t stride = MEMORY_ARENA_SNAPSHOT_PAGE_STRIDE;
+
+	for (uintptr_t offset = 0; offset < snapshot->pages_size; offset += stride)
+	{
+		MemoryArenaSnapshotPage* page = (MemoryArenaSnapshotPage*)(snapshot->pages + offset);
+		MemoryArenaSnapshotBlock* entry = &snapshot->blocks[page->block_index];
+		uint8_t* address = (uint8_t*)(entry->block + 1) + page->page_index * MEMORY_ARENA_SNAPSHOT_PAGE_SIZE;
+
+		memcpy(address, page + 1, page->size);
+		entry->dirty[page->page_index / 64] &= ~((uint64_t)1 << (page->page_index % 64));
+	}
+
+	snapshot->pages_size = 0;
+	arena->scope_count = snapshot->scope_count;
+	//NOTE: Later snapshots saw tops this just moved back, this one stays restorable
+	snapshot->rewind_count = ++arena->rewind_count;
+
+	return true;
+}
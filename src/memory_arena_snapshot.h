@@ -0,0 +1,92 @@
+
+#ifndef MEMORY_ARENA_SNAPSHOT_H
+# define MEMORY_ARENA_SNAPSHOT_H
+
+# include "memory_arena.h"
+# include <stdbool.h>
+
+/*
+| #MEMORY_ARENA_SNAPSHOT
+|
+|| #BLOCK :PER_SNAPSHOTTED_BLOCK
+|| >block
+|| >serial
+|| >top
+|| >dirty (one bit per page)
+|
+|| #SAVED_PAGE :FIRST_MARK_ONLY
+|| [[HEADER]-[OLD_BYTES]]
+|
+| >head_block
+| >scope_count
+|
+*/
+
+//NOTE: Granularity of the dirty marks, mark saves and restore copies whole pages
+# ifndef MEMORY_ARENA_SNAPSHOT_PAGE_SIZE
+#  define MEMORY_ARENA_SNAPSHOT_PAGE_SIZE 256
+# endif
+
+typedef struct
+{
+	MemoryArenaBlockFooter* block;
+	uintptr_t serial;
+	uintptr_t top;
+	uint64_t* dirty;
+}
+MemoryArenaSnapshotBlock;
+
+typedef struct
+{
+	uintptr_t block_index;
+	uintptr_t page_index;
+	uintptr_t size;
+	//NOTE: The page content from before the first write is right behind this struct
+}
+MemoryArenaSnapshotPage;
+
+typedef struct
+{
+	MemoryArena* arena;
+	MemoryArenaBlockFooter* head_block;
+	uintptr_t scope_count;
+	uintptr_t rewind_count;
+	MemoryArenaSnapshotBlock* blocks;
+	uintptr_t block_count;
+	//NOTE: Blocks and dirty bits live in this buffer, kept between captures
+	void* storage;
+	uintptr_t storage_capacity;
+	//NOTE: Saved pages, kept between captures too
+	uint8_t* pages;
+	uintptr_t pages_size;
+	uintptr_t pages_capacity;
+}
+MemoryArenaSnapshot;
+
+
+void
+memory_arena_snapshot_init(MemoryArenaSnapshot* snapshot);
+
+void
+memory_arena_snapshot_destroy(MemoryArenaSnapshot* snapshot);
+
+//NOTE: Only records the block chain and the tops, no arena data is copied
+bool
+memory_arena_snapshot(MemoryArenaSnapshot* snapshot, MemoryArena* arena);
+
+//NOTE: Call BEFORE writing to memory older than the snapshot, the first mark of a page saves it.
+//	Memory pushed after the snapshot does not need marks.
+bool
+memory_arena_snapshot_mark_dirty(MemoryArenaSnapshot* snapshot, const void* ptr, uintptr_t size);
+
+bool
+memory_arena_snapshot_mark_all_dirty(MemoryArenaSnapshot* snapshot);
+
+//NOTE: Copies the saved pages back and forgets them, the snapshot can be restored again.
+//	Returns false and leaves the arena alone when the arena was rewound since
+//	(memory_arena_clear, memory_arena_scope_end, restoring another snapshot, ...).
+//	Restoring this one invalidates snapshots taken after it.
+bool
+memory_arena_restore(MemoryArenaSnapshot* snapshot);
+
+#endif
@@ -0,0 +1,106 @@
+
+#include "memory_arena_soa.h"
+#include <assert.h>
+#include <string.h>
+
+static inline
+uintptr_t
+__memory_arena_soa_alignment(MemoryArenaSoa* soa)
+{
+	uintptr_t alignment = MEMORY_ARENA_SOA_ALIGNMENT;
+
+	for (uintptr_t i = 0; i < soa->field_count; i++)
+		alignment = MAX(alignment, soa->fields[i].alignment);
+
+	return alignment;
+}
+
+bool
+memory_arena_soa_init(MemoryArenaSoa* soa, MemoryArena* arena, const MemoryArenaSoaField* fields, uintptr_t field_count, uintptr_t capacity)
+{
+	assert(soa != NULL);
+	assert(arena != NULL);
+	assert(fields != NULL);
+	assert(field_count > 0);
+
+	*soa = (MemoryArenaSoa){0};
+	soa->arena = arena;
+	soa->fields = fields;
+	soa->field_count = field_count;
+	soa->columns = memory_arena_alloc_array(arena, void*, field_count);
+
+	if (soa->columns == NULL)
+		return false;
+
+	for (uintptr_t i = 0; i < field_count; i++)
+	{
+		assert(fields[i].alignment > 0);
+		assert((fields[i].alignment & (fields[i].alignment - 1)) == 0);
+		soa->columns[i] = NULL;
+	}
+
+	return memory_arena_soa_reserve(soa, capacity);
+}
+
+bool
+memory_arena_soa_reserve(MemoryArenaSoa* soa, uintptr_t capacity)
+{
+	assert(soa != NULL);
+
+	if (capacity <= soa->capacity)
+		return true;
+
+	uintptr_t alignment = __memory_arena_soa_alignment(soa);
+	uintptr_t total_size = 0;
+
+	//NOTE: Every column is padded up to the alignment so the next one starts aligned,
+	//	which also lets vector loops run over the tail without touching another column
+	for (uintptr_t i = 0; i < soa->field_count; i++)
+	{
+		uintptr_t field_size = soa->fields[i].size;
+
+		if (field_size != 0 && capacity > (UINTPTR_MAX - total_size) / field_size)
+			return false;
+		total_size = __align_forward(total_size + field_size * capacity, alignment);
+	}
+
+	//NOTE: One reservation for all columns, the old region is left behind in the arena
+	uint8_t* data = memory_arena_push(soa->arena, total_size, alignment);
+
+	if (data == NULL)
+		return false;
+
+	uintptr_t offset = 0;
+
+	for (uintptr_t i = 0; i < soa->field_count; i++)
+	{
+		uintptr_t field_size = soa->fields[i].size;
+
+		if (soa->count > 0)
+			memcpy(data + offset, soa->columns[i], field_size * soa->count);
+		soa->columns[i] = data + offset;
+		offset = __align_forward(offset + field_size * capacity, alignment);
+	}
+
+	soa->capacity = capacity;
+
+	return true;
+}
+
+bool
+memory_arena_soa_resize(MemoryArenaSoa* soa, uintptr_t count)
+{
+	assert(soa != NULL);
+
+	if (count > soa->capacity)
+	{
+		uintptr_t capacity = MAX(soa->capacity * 2, 16);
+
+		if (!memory_arena_soa_reserve(soa, MAX(capacity, count)))
+			return false;
+	}
+
+	soa->count = count;
+
+	return true;
+}
@@ -0,0 +1,60 @@
+
+#ifndef MEMORY_ARENA_SOA_H
+# define MEMORY_ARENA_SOA_H
+
+# include "memory_arena.h"
+# include <stdbool.h>
+
+/*
+| #MEMORY_ARENA_SOA
+|
+|| #FIELDS :DESCRIPTORS
+|| >size
+|| >alignment
+|
+|| #STORAGE :ONE_ARENA_PUSH
+|| [COLUMN_0]-PADDING-[COLUMN_1]-PADDING-[COLUMN_2]-PADDING
+|
+| >columns
+| >count
+| >capacity
+|
+*/
+
+//NOTE: Every column starts on this boundary (cache line / widest SIMD register)
+# ifndef MEMORY_ARENA_SOA_ALIGNMENT
+#  define MEMORY_ARENA_SOA_ALIGNMENT 64
+# endif
+
+typedef struct
+{
+	uintptr_t size;
+	uintptr_t alignment;
+}
+MemoryArenaSoaField;
+
+typedef struct
+{
+	MemoryArena* arena;
+	const MemoryArenaSoaField* fields;
+	uintptr_t field_count;
+	void** columns;
+	uintptr_t count;
+	uintptr_t capacity;
+}
+MemoryArenaSoa;
+
+
+bool
+memory_arena_soa_init(MemoryArenaSoa* soa, MemoryArena* arena, const MemoryArenaSoaField* fields, uintptr_t field_count, uintptr_t capacity);
+
+bool
+memory_arena_soa_reserve(MemoryArenaSoa* soa, uintptr_t capacity);
+
+bool
+memory_arena_soa_resize(MemoryArenaSoa* soa, uintptr_t count);
+
+# define MEMORY_ARENA_SOA_FIELD(TYPE) { sizeof(TYPE), _Alignof(TYPE) }
+# define memory_arena_soa_column(SOA, INDEX, TYPE) ((TYPE*)(SOA)->columns[(INDEX)])
+
+#endif
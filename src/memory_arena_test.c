@@ -4,7 +4,16 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <string.h>
+#include <threads.h>
+#include <unistd.h>
 #include "memory_arena.h"
+#include "memory_arena_soa.h"
+#include "memory_arena_intern.h"
+#include "memory_arena_snapshot.h"
+#include "memory_arena_queue.h"
+#include "memory_arena_typed.h"
+#include "memory_arena_shared.h"
+#include "memory_arena_file.h"
 
 // Helper to check pointer alignment
 static bool is_aligned(void *ptr, uintptr_t alignment)
@@ -532,6 +541,713 @@ void test_alignment_across_arena_activity()
 	printf("✓ Alignment across arena activity test passed\n");
 }
 
+void test_soa_columns()
+{
+	printf("Testing structure-of-arrays columns...\n");
+
+	MemoryArena arena;
+	memory_arena_init(&arena, 256);
+
+	enum { ENTITY_X, ENTITY_Y, ENTITY_ID, ENTITY_FLAGS };
+	static const MemoryArenaSoaField entity_fields[] = {
+		MEMORY_ARENA_SOA_FIELD(float),
+		MEMORY_ARENA_SOA_FIELD(float),
+		MEMORY_ARENA_SOA_FIELD(uint32_t),
+		MEMORY_ARENA_SOA_FIELD(uint8_t),
+	};
+
+	MemoryArenaSoa soa;
+	bool ok = memory_arena_soa_init(&soa, &arena, entity_fields, 4, 5);
+	assert(ok);
+	assert(soa.capacity == 5);
+	assert(soa.count == 0);
+
+	// Grow well past the initial capacity to force several relocations
+	for (uint32_t i = 0; i < 1000; i++) {
+		ok = memory_arena_soa_resize(&soa, i + 1);
+		assert(ok);
+
+		memory_arena_soa_column(&soa, ENTITY_X, float)[i] = (float)i;
+		memory_arena_soa_column(&soa, ENTITY_Y, float)[i] = (float)i * 2.0f;
+		memory_arena_soa_column(&soa, ENTITY_ID, uint32_t)[i] = i;
+		memory_arena_soa_column(&soa, ENTITY_FLAGS, uint8_t)[i] = (uint8_t)i;
+	}
+	assert(soa.count == 1000);
+	assert(soa.capacity >= 1000);
+
+	// Every column is aligned and the columns never overlap
+	for (uintptr_t c = 0; c < 4; c++) {
+		assert(is_aligned(soa.columns[c], MEMORY_ARENA_SOA_ALIGNMENT));
+		if (c > 0) {
+			uintptr_t prev_end = (uintptr_t)soa.columns[c - 1] + entity_fields[c - 1].size * soa.capacity;
+			assert((uintptr_t)soa.columns[c] >= prev_end);
+		}
+	}
+
+	// Data survived the relocations
+	for (uint32_t i = 0; i < 1000; i++) {
+		assert(memory_arena_soa_column(&soa, ENTITY_X, float)[i] == (float)i);
+		assert(memory_arena_soa_column(&soa, ENTITY_Y, float)[i] == (float)i * 2.0f);
+		assert(memory_arena_soa_column(&soa, ENTITY_ID, uint32_t)[i] == i);
+		assert(memory_arena_soa_column(&soa, ENTITY_FLAGS, uint8_t)[i] == (uint8_t)i);
+	}
+
+	// Shrinking keeps the storage, reserving less is a no-op
+	void* x_column = soa.columns[ENTITY_X];
+	ok = memory_arena_soa_resize(&soa, 10);
+	assert(ok && soa.count == 10);
+	ok = memory_arena_soa_reserve(&soa, 20);
+	assert(ok && soa.columns[ENTITY_X] == x_column);
+
+	memory_arena_destroy(&arena);
+	printf("✓ SoA columns test passed\n");
+}
+
+void test_string_interning()
+{
+	printf("Testing string interning...\n");
+
+	MemoryArena arena;
+	memory_arena_init(&arena, 512);
+
+	MemoryArenaInternTable table;
+	memory_arena_intern_init(&table, &arena, 4);
+
+	// Same bytes give the same pointer
+	const char* a = memory_arena_intern_cstr(&table, "player_position");
+	const char* b = memory_arena_intern(&table, "player_position_x", 15);
+	const char* c = memory_arena_intern_cstr(&table, "player_velocity");
+	assert(a != NULL && c != NULL);
+	assert(a == b);
+	assert(a != c);
+	assert(strcmp(a, "player_position") == 0);
+	assert(memory_arena_interned_length(a) == 15);
+	assert(table.count == 2);
+
+	// Empty string is a valid key
+	const char* empty = memory_arena_intern(&table, "", 0);
+	assert(empty != NULL && empty[0] == '\0');
+	assert(memory_arena_intern(&table, NULL, 0) == empty);
+
+	// Many keys force the slot array to grow
+	char name[32];
+	const char* names[2000];
+	for (int i = 0; i < 2000; i++) {
+		snprintf(name, sizeof(name), "identifier_%d", i);
+		names[i] = memory_arena_intern_cstr(&table, name);
+		assert(names[i] != NULL);
+	}
+	assert(table.count == 2003);
+	for (int i = 0; i < 2000; i++) {
+		snprintf(name, sizeof(name), "identifier_%d", i);
+		assert(memory_arena_intern_find(&table, name, strlen(name)) == names[i]);
+		assert(memory_arena_intern_cstr(&table, name) == names[i]);
+	}
+	assert(table.count == 2003);
+	assert(memory_arena_intern_find(&table, "missing", 7) == NULL);
+	assert(memory_arena_intern_find(&table, "player_position", 15) == a);
+
+	// Hash covers every length bucket and depends on every byte
+	char buffer[128];
+	memset(buffer, 'x', sizeof(buffer));
+	for (uintptr_t len = 1; len < sizeof(buffer); len++) {
+		uint64_t before = memory_arena_hash(buffer, len, 0);
+		buffer[len - 1] = 'y';
+		assert(memory_arena_hash(buffer, len, 0) != before);
+		assert(memory_arena_hash(buffer, len, 1) != memory_arena_hash(buffer, len, 0));
+		buffer[len - 1] = 'x';
+	}
+
+	// Bulk drop through the arena
+	memory_arena_clear(&arena);
+	memory_arena_intern_clear(&table);
+	assert(table.count == 0);
+	assert(memory_arena_intern_find(&table, "player_position", 15) == NULL);
+	a = memory_arena_intern_cstr(&table, "player_position");
+	assert(a != NULL && strcmp(a, "player_position") == 0);
+
+	memory_arena_destroy(&arena);
+	printf("✓ String interning test passed\n");
+}
+
+void test_snapshot_restore()
+{
+	printf("Testing snapshot and restore...\n");
+
+	MemoryArena arena;
+	memory_arena_init(&arena, 4096);
+
+	// Game state spread over a few blocks
+	int* state_a = memory_arena_alloc_array(&arena, int, 800);
+	int* state_b = memory_arena_alloc_array(&arena, int, 800);
+	for (int i = 0; i < 800; i++) {
+		state_a[i] = i;
+		state_b[i] = -i;
+	}
+	MemoryArenaBlockFooter* head_before = arena.head_block;
+	uintptr_t top_before = arena.head_block->top;
+
+	MemoryArenaSnapshot snapshot;
+	memory_arena_snapshot_init(&snapshot);
+	bool ok = memory_arena_snapshot(&snapshot, &arena);
+	assert(ok);
+	assert(snapshot.block_count == 2);
+
+	// Simulate a frame: mark old memory before touching it, push new memory and new blocks
+	for (int frame = 0; frame < 3; frame++) {
+		ok = memory_arena_snapshot_mark_dirty(&snapshot, &state_a[10], sizeof(int));
+		assert(ok);
+		state_a[10] = 1000 + frame;
+		ok = memory_arena_snapshot_mark_dirty(&snapshot, &state_b[500], sizeof(int) * 200);
+		assert(ok);
+		for (int i = 500; i < 700; i++)
+			state_b[i] = 7;
+		// Marking a page again does not overwrite its saved content
+		ok = memory_arena_snapshot_mark_dirty(&snapshot, &state_a[10], sizeof(int));
+		assert(ok);
+
+		void* temp = memory_arena_push(&arena, 10000, 8);
+		assert(temp != NULL);
+		memset(temp, 0xAB, 10000);
+		assert(arena.head_block != head_before);
+
+		ok = memory_arena_restore(&snapshot);
+		assert(ok);
+
+		assert(arena.head_block == head_before);
+		assert(arena.head_block->top == top_before);
+		assert(snapshot.pages_size == 0);
+		for (int i = 0; i < 800; i++) {
+			assert(state_a[i] == i);
+			assert(state_b[i] == -i);
+		}
+	}
+
+	// Unmarked writes are not rolled back, marking everything first restores them
+	state_a[0] = 42;
+	ok = memory_arena_restore(&snapshot);
+	assert(ok && state_a[0] == 42);
+	ok = memory_arena_snapshot_mark_all_dirty(&snapshot);
+	assert(ok);
+	state_a[0] = 43;
+	state_b[799] = 43;
+	ok = memory_arena_restore(&snapshot);
+	assert(ok && state_a[0] == 42 && state_b[799] == -799);
+
+	// Recapturing reuses the storage and follows the new state
+	void* storage = snapshot.storage;
+	state_a[1] = 11;
+	ok = memory_arena_snapshot(&snapshot, &arena);
+	assert(ok && snapshot.storage == storage);
+	memory_arena_snapshot_mark_dirty(&snapshot, state_a, sizeof(int) * 800);
+	state_a[1] = 12;
+	ok = memory_arena_restore(&snapshot);
+	assert(ok && state_a[1] == 11);
+
+	// A chain freed since the capture is detected, the arena is left alone
+	memory_arena_clear(&arena);
+	void* after_clear = memory_arena_push(&arena, 20000, 8);
+	assert(after_clear != NULL);
+	MemoryArenaBlockFooter* head_after_clear = arena.head_block;
+	uintptr_t top_after_clear = head_after_clear->top;
+	ok = memory_arena_restore(&snapshot);
+	assert(!ok);
+	assert(arena.head_block == head_after_clear);
+	assert(arena.head_block->top == top_after_clear);
+
+	// Same when a scope ends past the snapshot
+	MemoryArenaScope scope = memory_arena_scope_start(&arena);
+	memory_arena_push(&arena, 20000, 8);
+	ok = memory_arena_snapshot(&snapshot, &arena);
+	assert(ok);
+	memory_arena_scope_end(scope);
+	memory_arena_push(&arena, 20000, 8);
+	ok = memory_arena_restore(&snapshot);
+	assert(!ok);
+	memory_arena_snapshot_destroy(&snapshot);
+	memory_arena_destroy(&arena);
+
+	// Single block, a clear rewinds inside the captured block and new pushes reuse its bytes
+	memory_arena_init(&arena, 4096);
+	int* small = memory_arena_alloc_array(&arena, int, 16);
+	for (int i = 0; i < 16; i++)
+		small[i] = i;
+	memory_arena_snapshot_init(&snapshot);
+	ok = memory_arena_snapshot(&snapshot, &arena);
+	assert(ok && snapshot.block_count == 1);
+	memory_arena_clear(&arena);
+	int* reused = memory_arena_alloc_array(&arena, int, 16);
+	assert(reused == small);
+	memset(reused, 0xFF, sizeof(int) * 16);
+	ok = memory_arena_restore(&snapshot);
+	assert(!ok);
+
+	// Same with a scope ending inside the captured block
+	for (int i = 0; i < 16; i++)
+		small[i] = i;
+	MemoryArenaScope inner = memory_arena_scope_start(&arena);
+	int* scoped = memory_arena_alloc_array(&arena, int, 16);
+	ok = memory_arena_snapshot(&snapshot, &arena);
+	assert(ok && snapshot.block_count == 1);
+	memory_arena_scope_end(inner);
+	reused = memory_arena_alloc_array(&arena, int, 16);
+	assert(reused == scoped);
+	ok = memory_arena_restore(&snapshot);
+	assert(!ok);
+
+	// Restoring twice is fine, restoring an older snapshot invalidates newer ones
+	MemoryArenaSnapshot newer;
+	memory_arena_snapshot_init(&newer);
+	ok = memory_arena_snapshot(&snapshot, &arena);
+	assert(ok);
+	memory_arena_push(&arena, 64, 8);
+	ok = memory_arena_snapshot(&newer, &arena);
+	assert(ok);
+	assert(memory_arena_restore(&snapshot));
+	assert(memory_arena_restore(&snapshot));
+	assert(!memory_arena_restore(&newer));
+
+	memory_arena_snapshot_destroy(&newer);
+	memory_arena_snapshot_destroy(&snapshot);
+	memory_arena_destroy(&arena);
+	printf("✓ Snapshot and restore test passed\n");
+}
+
+typedef struct
+{
+	uint32_t producer_id;
+	uint32_t sequence;
+	uint32_t length;
+	uint8_t bytes[];
+}
+QueueTestMessage;
+
+#define QUEUE_TEST_PRODUCERS 3
+#define QUEUE_TEST_MESSAGES 20000
+
+typedef struct
+{
+	MemoryArenaQueueProducer producer;
+	uint32_t id;
+}
+QueueTestThread;
+
+static int queue_test_thread(void* user)
+{
+	QueueTestThread* thread = user;
+
+	for (uint32_t i = 0; i < QUEUE_TEST_MESSAGES; i++) {
+		uint32_t length = (i * 7) % 200;
+		QueueTestMessage* message = memory_arena_queue_push(&thread->producer,
+			sizeof(QueueTestMessage) + length, _Alignof(QueueTestMessage));
+		assert(message != NULL);
+
+		message->producer_id = thread->id;
+		message->sequence = i;
+		message->length = length;
+		memset(message->bytes, (int)(i & 0xFF), length);
+
+		memory_arena_queue_publish(&thread->producer, message);
+	}
+	return 0;
+}
+
+void test_message_queue()
+{
+	printf("Testing zero-copy message queue...\n");
+
+	MemoryArenaQueue queue;
+	memory_arena_queue_init(&queue);
+	assert(memory_arena_queue_pop(&queue, NULL) == NULL);
+
+	// Single thread round trip, payload is passed by pointer
+	QueueTestThread local = {0};
+	memory_arena_queue_producer_init(&local.producer, &queue, 256);
+	uint64_t* value = memory_arena_queue_alloc(&local.producer, uint64_t);
+	assert(value != NULL && is_aligned(value, _Alignof(uint64_t)));
+	*value = 0x1234;
+	memory_arena_queue_publish(&local.producer, value);
+
+	uintptr_t size = 0;
+	void* popped = memory_arena_queue_pop(&queue, &size);
+	assert(popped == value && size == sizeof(uint64_t));
+	assert(*(uint64_t*)popped == 0x1234);
+	assert(memory_arena_queue_pop(&queue, NULL) == NULL);
+	memory_arena_queue_release(popped);
+
+	// Over-aligned payloads
+	void* wide = memory_arena_queue_push(&local.producer, 64, 64);
+	assert(wide != NULL && is_aligned(wide, 64));
+	memory_arena_queue_publish(&local.producer, wide);
+	assert(memory_arena_queue_pop(&queue, NULL) == wide);
+	memory_arena_queue_release(wide);
+
+	// Consumed blocks are recycled instead of growing the producer
+	for (int i = 0; i < 1000; i++) {
+		void* payload = memory_arena_queue_push(&local.producer, 100, 8);
+		assert(payload != NULL);
+		memory_arena_queue_publish(&local.producer, payload);
+		assert(memory_arena_queue_pop(&queue, NULL) == payload);
+		memory_arena_queue_release(payload);
+	}
+	assert(local.producer.block_count <= 2);
+
+	// Messages bigger than a block get their own, the small blocks stay in use
+	uintptr_t block_count = local.producer.block_count;
+	void* big = memory_arena_queue_push(&local.producer, 1000, 8);
+	assert(big != NULL);
+	memory_arena_queue_publish(&local.producer, big);
+	assert(memory_arena_queue_pop(&queue, NULL) == big);
+	memory_arena_queue_release(big);
+	for (int i = 0; i < 100; i++) {
+		void* payload = memory_arena_queue_push(&local.producer, 100, 8);
+		memory_arena_queue_publish(&local.producer, payload);
+		assert(memory_arena_queue_pop(&queue, NULL) == payload);
+		memory_arena_queue_release(payload);
+	}
+	assert(local.producer.block_count <= block_count + 2);
+
+	// A held message keeps the producer alive until it is released
+	void* held = memory_arena_queue_push(&local.producer, 16, 8);
+	memory_arena_queue_publish(&local.producer, held);
+	assert(memory_arena_queue_pop(&queue, NULL) == held);
+	assert(!memory_arena_queue_producer_destroy(&local.producer));
+	memory_arena_queue_release(held);
+	assert(memory_arena_queue_producer_destroy(&local.producer));
+
+	// Several producer threads, consumed blocks go back to their producer
+	QueueTestThread threads[QUEUE_TEST_PRODUCERS];
+	thrd_t handles[QUEUE_TEST_PRODUCERS];
+	uint32_t expected[QUEUE_TEST_PRODUCERS] = {0};
+
+	for (uint32_t t = 0; t < QUEUE_TEST_PRODUCERS; t++) {
+		threads[t].id = t;
+		memory_arena_queue_producer_init(&threads[t].producer, &queue, 4096);
+		int result = thrd_create(&handles[t], queue_test_thread, &threads[t]);
+		assert(result == thrd_success);
+	}
+
+	uint32_t received = 0;
+	while (received < QUEUE_TEST_PRODUCERS * QUEUE_TEST_MESSAGES) {
+		QueueTestMessage* message = memory_arena_queue_pop(&queue, &size);
+		if (message == NULL) {
+			thrd_yield();
+			continue;
+		}
+
+		assert(message->producer_id < QUEUE_TEST_PRODUCERS);
+		assert(message->sequence == expected[message->producer_id]);
+		assert(size == sizeof(QueueTestMessage) + message->length);
+		for (uint32_t i = 0; i < message->length; i++)
+			assert(message->bytes[i] == (uint8_t)(message->sequence & 0xFF));
+
+		expected[message->producer_id]++;
+		received++;
+		memory_arena_queue_release(message);
+	}
+
+	for (uint32_t t = 0; t < QUEUE_TEST_PRODUCERS; t++) {
+		thrd_join(handles[t], NULL);
+		assert(expected[t] == QUEUE_TEST_MESSAGES);
+		bool destroyed = memory_arena_queue_producer_destroy(&threads[t].producer);
+		assert(destroyed);
+	}
+	assert(memory_arena_queue_pop(&queue, NULL) == NULL);
+
+	printf("✓ Message queue test passed\n");
+}
+
+typedef struct
+{
+	float position[3];
+	float velocity[3];
+	uint32_t id;
+}
+TypedTestEntity;
+
+MEMORY_ARENA_TYPED_DEFINE(TypedTestEntityArena, TypedTestEntity)
+
+void test_typed_arena()
+{
+	printf("Testing typed iterable arena...\n");
+
+	MemoryArena arena;
+	memory_arena_init(&arena, 1024);
+
+	TypedTestEntityArena entities;
+	TypedTestEntityArena_init(&entities, &arena, 100);
+
+	// Interleave other arena traffic, the typed blocks must stay dense
+	for (uint32_t i = 0; i < 1050; i++) {
+		TypedTestEntity* entity = TypedTestEntityArena_push(&entities);
+		assert(entity != NULL);
+		entity->id = i;
+		entity->position[0] = (float)i;
+		entity->velocity[0] = 1.0f;
+		if (i % 100 == 0)
+			memory_arena_push(&arena, 37, 1);
+	}
+	assert(entities.count == 1050);
+	assert(entities.block_count == 11);
+
+	// Block-wise update pass over contiguous spans
+	TypedTestEntityArenaBlock* block;
+	uint32_t expected_id = 0;
+	uintptr_t visited = 0;
+	memory_arena_typed_foreach_block(block, &entities) {
+		assert(is_aligned(block->items, MEMORY_ARENA_TYPED_ALIGNMENT));
+		assert(block->count <= block->capacity);
+		for (uintptr_t i = 0; i < block->count; i++) {
+			assert(block->items[i].id == expected_id++);
+			block->items[i].position[0] += block->items[i].velocity[0];
+		}
+		visited += block->count;
+	}
+	assert(visited == 1050);
+
+	// Array pushes stay contiguous, even past the block capacity
+	TypedTestEntity* batch = TypedTestEntityArena_push_array(&entities, 250);
+	assert(batch != NULL);
+	assert(entities.last->items == batch && entities.last->count == 250);
+	batch[249].id = 7;
+
+	memory_arena_typed_foreach_block(block, &entities) {
+		if (block == entities.last)
+			break;
+		for (uintptr_t i = 0; i < block->count; i++)
+			assert(block->items[i].position[0] == (float)block->items[i].id + 1.0f);
+	}
+
+	memory_arena_clear(&arena);
+	TypedTestEntityArena_clear(&entities);
+	assert(entities.first == NULL && entities.count == 0);
+	assert(TypedTestEntityArena_push(&entities) != NULL);
+	assert(entities.block_count == 1);
+
+	memory_arena_destroy(&arena);
+	printf("✓ Typed arena test passed\n");
+}
+
+typedef struct
+{
+	uint32_t frame;
+	uint32_t vertex_count;
+	MemoryArenaSharedOffset vertices;
+}
+SharedTestFrame;
+
+void test_shared_arena()
+{
+	printf("Testing cross-process shared arena...\n");
+
+	char name[64];
+	snprintf(name, sizeof(name), "/memory_arena_test_%ld", (long)getpid());
+
+	MemoryArenaShared writer;
+	bool ok = memory_arena_shared_create(&writer, name, 1 << 16);
+	assert(ok);
+
+	// A second mapping stands in for the other process, it lands at another address
+	MemoryArenaShared reader;
+	ok = memory_arena_shared_open(&reader, name);
+	assert(ok);
+	assert(reader.base != writer.base);
+	memory_arena_shared_unlink(name);
+
+	MemoryArenaSharedOffset root;
+	uint64_t generation = memory_arena_shared_published(&reader, &root, NULL);
+	assert(root == MEMORY_ARENA_SHARED_NULL);
+	assert(memory_arena_shared_validate(&reader, generation));
+
+	for (uint32_t frame = 0; frame < 3; frame++) {
+		// A reset invalidates what readers got before, and reads during the write
+		memory_arena_shared_reset(&writer);
+		assert(!memory_arena_shared_validate(&reader, generation));
+		uint64_t writing = memory_arena_shared_published(&reader, NULL, NULL);
+		assert(!memory_arena_shared_validate(&reader, writing));
+
+		SharedTestFrame* data = memory_arena_shared_alloc(&writer, SharedTestFrame);
+		float* vertices = memory_arena_shared_alloc_array(&writer, float, 1000);
+		assert(data != NULL && vertices != NULL);
+		assert(is_aligned(vertices, _Alignof(float)));
+		for (int i = 0; i < 1000; i++)
+			vertices[i] = (float)(i + frame);
+		data->frame = frame;
+		data->vertex_count = 1000;
+		data->vertices = memory_arena_shared_offset(&writer, vertices);
+
+		memory_arena_shared_publish(&writer, memory_arena_shared_offset(&writer, data));
+
+		uintptr_t top;
+		uint64_t new_generation = memory_arena_shared_published(&reader, &root, &top);
+		assert(new_generation != generation);
+		generation = new_generation;
+
+		// Offsets are checked before they are followed, they may be torn until validated
+		const SharedTestFrame* view = memory_arena_shared_resolve_type(&reader, root, const SharedTestFrame);
+		assert(view != NULL && view != data);
+		assert(view->frame == frame);
+		const float* view_vertices = memory_arena_shared_resolve_array(&reader, view->vertices, const float, view->vertex_count);
+		assert(view_vertices != NULL);
+		assert(view_vertices + view->vertex_count <= (const float*)(reader.base + top));
+		for (uint32_t i = 0; i < view->vertex_count; i++)
+			assert(view_vertices[i] == (float)(i + frame));
+		assert(memory_arena_shared_validate(&reader, generation));
+	}
+
+	// Garbage offsets resolve to NULL instead of pointing out of the mapping
+	assert(memory_arena_shared_resolve(&reader, MEMORY_ARENA_SHARED_NULL, 4, 4) == NULL);
+	assert(memory_arena_shared_resolve(&reader, 8, 4, 4) == NULL);
+	assert(memory_arena_shared_resolve(&reader, reader.size - 4, 8, 4) == NULL);
+	assert(memory_arena_shared_resolve(&reader, 0xDEADBEEFDEADBEEFull, 4, 4) == NULL);
+	assert(memory_arena_shared_resolve(&reader, root, UINTPTR_MAX, 1) == NULL);
+	assert(memory_arena_shared_resolve(&reader, root + 1, 4, 4) == NULL);
+	assert(memory_arena_shared_resolve(&reader, reader.size - 4, 4, 4) != NULL);
+
+	// Publishing more data without a reset keeps older offsets valid, the generation still moves
+	uint32_t* extra = memory_arena_shared_alloc(&writer, uint32_t);
+	assert(extra != NULL);
+	memory_arena_shared_publish(&writer, memory_arena_shared_offset(&writer, extra));
+	assert(!memory_arena_shared_validate(&reader, generation));
+	generation = memory_arena_shared_published(&reader, &root, NULL);
+	assert(memory_arena_shared_validate(&reader, generation));
+
+	// Fixed capacity, running out fails instead of growing
+	assert(memory_arena_shared_push(&writer, 1 << 17, 8) == NULL);
+
+	// Anonymous memfd region shared by descriptor
+	MemoryArenaShared anonymous;
+	if (memory_arena_shared_create(&anonymous, NULL, 4096)) {
+		uint32_t* value = memory_arena_shared_alloc(&anonymous, uint32_t);
+		*value = 0xC0FFEE;
+		memory_arena_shared_publish(&anonymous, memory_arena_shared_offset(&anonymous, value));
+
+		MemoryArenaShared view;
+		ok = memory_arena_shared_open_fd(&view, dup(anonymous.fd));
+		assert(ok);
+		memory_arena_shared_published(&view, &root, NULL);
+		assert(*memory_arena_shared_resolve_type(&view, root, uint32_t) == 0xC0FFEE);
+		memory_arena_shared_close(&view);
+		memory_arena_shared_close(&anonymous);
+	}
+
+	memory_arena_shared_close(&reader);
+	memory_arena_shared_close(&writer);
+	printf("✓ Shared arena test passed\n");
+}
+
+// Helper to write a test file with a byte pattern derived from its index
+static void write_test_file(const char* path, uintptr_t size, int seed)
+{
+	FILE* file = fopen(path, "wb");
+	assert(file != NULL);
+	for (uintptr_t i = 0; i < size; i++)
+		fputc((int)((i * 31 + seed) & 0xFF), file);
+	fclose(file);
+}
+
+static bool check_test_bytes(const uint8_t* data, uintptr_t offset, uintptr_t size, int seed)
+{
+	for (uintptr_t i = 0; i < size; i++) {
+		if (data[i] != (uint8_t)(((offset + i) * 31 + seed) & 0xFF))
+			return false;
+	}
+	return true;
+}
+
+void test_file_loading()
+{
+	printf("Testing file loading into the arena...\n");
+
+	MemoryArena arena;
+	memory_arena_init(&arena, 1 << 16);
+
+#define FILE_TEST_COUNT 40
+	char paths[FILE_TEST_COUNT][64];
+	uintptr_t sizes[FILE_TEST_COUNT];
+	MemoryArenaFile files[FILE_TEST_COUNT + 1];
+
+	for (int i = 0; i < FILE_TEST_COUNT; i++) {
+		snprintf(paths[i], sizeof(paths[i]), "memory_arena_test_%ld_%d.bin", (long)getpid(), i);
+		sizes[i] = (uintptr_t)(i * 997) % 20000;
+		write_test_file(paths[i], sizes[i], i);
+	}
+
+	// Single file, NUL terminated, with and without O_DIRECT
+	uint32_t modes[] = {0, MEMORY_ARENA_FILE_DIRECT, MEMORY_ARENA_FILE_NO_URING};
+	for (int m = 0; m < 3; m++) {
+		uintptr_t size = 0;
+		uint8_t* data = memory_arena_read_file(&arena, paths[7], &size, modes[m]);
+		assert(data != NULL);
+		assert(size == sizes[7]);
+		assert(data[size] == '\0');
+		assert(check_test_bytes(data, 0, size, 7));
+	}
+	assert(memory_arena_read_file(&arena, "memory_arena_test_missing.bin", NULL, 0) == NULL);
+
+	// Batches, io_uring where available, pread otherwise
+	for (int m = 0; m < 3; m++) {
+		for (int i = 0; i < FILE_TEST_COUNT; i++)
+			files[i].path = paths[i];
+		files[FILE_TEST_COUNT].path = "memory_arena_test_missing.bin";
+
+		bool ok = memory_arena_read_files(&arena, files, FILE_TEST_COUNT + 1, modes[m]);
+		assert(!ok);
+		assert(files[FILE_TEST_COUNT].data == NULL);
+		assert(files[FILE_TEST_COUNT].error != 0);
+
+		for (int i = 0; i < FILE_TEST_COUNT; i++) {
+			assert(files[i].error == 0);
+			assert(files[i].data != NULL);
+			assert(files[i].size == sizes[i]);
+			assert(((uint8_t*)files[i].data)[sizes[i]] == '\0');
+			assert(check_test_bytes(files[i].data, 0, sizes[i], i));
+			// Filesystems without O_DIRECT fall back to the page cache
+			assert(files[i].direct == false || (modes[m] & MEMORY_ARENA_FILE_DIRECT));
+			if (files[i].direct)
+				assert(is_aligned(files[i].data, MEMORY_ARENA_FILE_DIRECT_ALIGNMENT));
+			else
+				assert(is_aligned(files[i].data, 16));
+		}
+	}
+
+	// Streaming in chunks, the next chunk is read while this one is parsed
+	for (int m = 0; m < 3; m++) {
+		MemoryArenaFileStream stream;
+		bool ok = memory_arena_file_stream_open(&stream, &arena, paths[19], 4096, modes[m]);
+		assert(ok);
+		if (stream.direct) {
+			assert(is_aligned(stream.buffers[0], MEMORY_ARENA_FILE_DIRECT_ALIGNMENT));
+			assert(is_aligned(stream.buffers[1], MEMORY_ARENA_FILE_DIRECT_ALIGNMENT));
+		}
+
+		uintptr_t offset = 0;
+		uintptr_t size;
+		const uint8_t* chunk;
+		while ((chunk = memory_arena_file_stream_next(&stream, &size)) != NULL) {
+			assert(size > 0 && size <= stream.chunk_size);
+			assert(check_test_bytes(chunk, offset, size, 19));
+			offset += size;
+		}
+		assert(offset == sizes[19]);
+		assert(stream.error == 0);
+		memory_arena_file_stream_close(&stream);
+	}
+
+	// Closing in the middle of a stream
+	MemoryArenaFileStream stream;
+	bool ok = memory_arena_file_stream_open(&stream, &arena, paths[19], 1000, 0);
+	assert(ok);
+	assert(memory_arena_file_stream_next(&stream, NULL) != NULL);
+	memory_arena_file_stream_close(&stream);
+
+	for (int i = 0; i < FILE_TEST_COUNT; i++)
+		remove(paths[i]);
+
+	memory_arena_destroy(&arena);
+	printf("✓ File loading test passed\n");
+}
+
 int main()
 {
 	printf("=== Memory Arena Test Suite ===\n");
@@ -547,6 +1263,27 @@ int main()
 	test_complex_scenario();
 	test_alignment_across_arena_activity(); // Add the new test
 
+	printf("	- For SoA Columns\n");
+	test_soa_columns();
+
+	printf("	- For String Interning\n");
+	test_string_interning();
+
+	printf("	- For Snapshots\n");
+	test_snapshot_restore();
+
+	printf("	- For Message Queue\n");
+	test_message_queue();
+
+	printf("	- For Typed Arena\n");
+	test_typed_arena();
+
+	printf("	- For Shared Arena\n");
+	test_shared_arena();
+
+	printf("	- For File Loading\n");
+	test_file_loading();
+
 	printf("All tests passed successfully!\n");
 	return 0;
 }
\ No newline at end of file
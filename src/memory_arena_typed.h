@@ -0,0 +1,116 @@
+
+#ifndef MEMORY_ARENA_TYPED_H
+# define MEMORY_ARENA_TYPED_H
+
+# include "memory_arena.h"
+
+/*
+| #MEMORY_ARENA_TYPED :MACRO_GENERATED
+|
+|| #BLOCK :LINKED_LIST (oldest first)
+|| >items (aligned, contiguous)
+|| >count
+|| >capacity
+|| >next
+|
+| >first
+| >last
+| >count
+| >block_count
+|
+*/
+
+//NOTE: The items of every block start on this boundary
+# ifndef MEMORY_ARENA_TYPED_ALIGNMENT
+#  define MEMORY_ARENA_TYPED_ALIGNMENT 64
+# endif
+
+# define MEMORY_ARENA_TYPED_DEFINE(NAME, TYPE)                                                  \
+                                                                                                \
+typedef struct NAME##Block                                                                      \
+{                                                                                               \
+	struct NAME##Block* next;                                                                   \
+	TYPE* items;                                                                                \
+	uintptr_t count;                                                                            \
+	uintptr_t capacity;                                                                         \
+}                                                                                               \
+NAME##Block;                                                                                    \
+                                                                                                \
+typedef struct                                                                                  \
+{                                                                                               \
+	MemoryArena* arena;                                                                         \
+	NAME##Block* first;                                                                         \
+	NAME##Block* last;                                                                          \
+	uintptr_t block_capacity;                                                                   \
+	uintptr_t block_count;                                                                      \
+	uintptr_t count;                                                                            \
+}                                                                                               \
+NAME;                                                                                           \
+                                                                                                \
+static inline                                                                                   \
+void                                                                                            \
+NAME##_init(NAME* typed, MemoryArena* arena, uintptr_t block_capacity)                          \
+{                                                                                               \
+	*typed = (NAME){0};                                                                         \
+	typed->arena = arena;                                                                       \
+	typed->block_capacity = MAX(block_capacity, 1);                                             \
+}                                                                                               \
+                                                                                                \
+/* NOTE: Forgets the items, their memory goes back when the backing arena is cleared */         \
+static inline                                                                                   \
+void                                                                                            \
+NAME##_clear(NAME* typed)                                                                       \
+{                                                                                               \
+	NAME##_init(typed, typed->arena, typed->block_capacity);                                    \
+}                                                                                               \
+                                                                                                \
+static inline                                                                                   \
+TYPE*                                                                                           \
+NAME##_push_array(NAME* typed, uintptr_t count)                                                 \
+{                                                                                               \
+	NAME##Block* block = typed->last;                                                           \
+                                                                                                \
+	if (block == NULL || block->count + count > block->capacity)                                \
+	{                                                                                           \
+		uintptr_t capacity = MAX(typed->block_capacity, count);                                 \
+		uintptr_t alignment = MAX(MEMORY_ARENA_TYPED_ALIGNMENT, _Alignof(TYPE));                \
+		uintptr_t items_offset = __align_forward(sizeof(NAME##Block), alignment);               \
+		uint8_t* data = memory_arena_push(typed->arena,                                         \
+			items_offset + sizeof(TYPE) * capacity, MAX(alignment, _Alignof(NAME##Block)));     \
+                                                                                                \
+		if (data == NULL)                                                                       \
+			return NULL;                                                                        \
+                                                                                                \
+		block = (NAME##Block*)data;                                                             \
+		*block = (NAME##Block){0};                                                              \
+		block->items = (TYPE*)(data + items_offset);                                            \
+		block->capacity = capacity;                                                             \
+                                                                                                \
+		if (typed->last)                                                                        \
+			typed->last->next = block;                                                          \
+		else                                                                                    \
+			typed->first = block;                                                               \
+		typed->last = block;                                                                    \
+		typed->block_count++;                                                                   \
+	}                                                                                           \
+                                                                                                \
+	TYPE* items = block->items + block->count;                                                  \
+                                                                                                \
+	block->count += count;                                                                      \
+	typed->count += count;                                                                      \
+                                                                                                \
+	return items;                                                                               \
+}                                                                                               \
+                                                                                                \
+static inline                                                                                   \
+TYPE*                                                                                           \
+NAME##_push(NAME* typed)                                                                        \
+{                                                                                               \
+	return NAME##_push_array(typed, 1);                                                         \
+}
+
+//NOTE: Walks the contiguous spans, BLOCK->items[0 .. BLOCK->count) per iteration
+# define memory_arena_typed_foreach_block(BLOCK, TYPED)                                         \
+	for (BLOCK = (TYPED)->first; BLOCK; BLOCK = BLOCK->next)
+
+#endif